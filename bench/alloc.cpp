@@ -0,0 +1,150 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Counts heap allocations per frame in the cpu and proc box draws and in rendering their output to html for the websocket, and for
+//* building box lines with Mv and string concatenation against Esc::writer
+//* usage: alloc [backend spec] [frames], default "synthetic:cores=32,procs=1000" and 50 frames
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+
+#include <btop_shared.hpp>
+#include <btop_config.hpp>
+#include <btop_theme.hpp>
+#include <btop_draw.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+#include <vt_renderer.hpp>
+
+using std::cout, std::string, std::vector, std::to_string;
+using namespace Tools;
+
+namespace {
+	size_t allocations = 0;
+}
+
+void* operator new(size_t size) {
+	allocations++;
+	if (void* ptr = std::malloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+	struct counter {
+		size_t total = 0, start = 0;
+		void begin() { start = allocations; }
+		void end() { total += allocations - start; }
+	};
+
+	//* Allocations per frame for each draw, <force_redraw> rebuilds the box chrome and empties the line caches every frame
+	void count_draws(const int frames, const bool force_redraw) {
+		Backend::cpu_sample cpu_sample;
+		Backend::mem_sample mem_sample;
+		Backend::proc_list proc_sample;
+		Cpu::cpu_info cpu;
+		vector<Proc::proc_info> procs;
+		VT::Renderer renderer(Term::width, Term::height);
+		counter cpu_draw, proc_draw, html;
+
+		//? First frames fill the graphs and caches and aren't counted
+		for (int i = -5; i < frames; i++) {
+			Backend::source->cpu(cpu_sample);
+			Backend::source->mem(mem_sample);
+			Backend::source->procs(proc_sample);
+			Shared::coreCount = cpu_sample.cores.size();
+			Mem::totalMem = mem_sample.total;
+			Cpu::apply_sample(cpu, cpu_sample);
+			Proc::apply_sample(procs, proc_sample, false);
+			Proc::arrange(procs, Config::getS("proc_sorting"), false, "", false, false, false, true, i == -5);
+
+			const bool counted = (i >= 0);
+			if (counted) cpu_draw.begin();
+			const auto cpu_out = Cpu::draw(cpu, force_redraw or i == -5);
+			if (counted) cpu_draw.end();
+			if (counted) proc_draw.begin();
+			const auto proc_out = Proc::draw(procs, force_redraw or i == -5);
+			if (counted) proc_draw.end();
+
+			//? Same order as the websocket frame, the returned html is the one allocation each frame needs
+			if (counted) html.begin();
+			for (const auto part : {cpu_out.chrome, cpu_out.content, proc_out.chrome, proc_out.content}) renderer.processSequence(part);
+			const string page = renderer.renderToResoniteHTML();
+			if (counted) html.end();
+		}
+
+		cout << "  " << std::left << std::setw(16) << (force_redraw ? "redraw" : "update") << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(10) << (double)cpu_draw.total / frames << std::setw(10) << (double)proc_draw.total / frames
+			<< std::setw(10) << (double)html.total / frames << '\n';
+	}
+
+	//* Allocations for <lines> lines of moves, colors, justified numbers and repeated symbols like the ones createBox and the draws write
+	void count_lines(const int lines) {
+		const string color = Theme::c("main_fg");
+		const string line_symbol = Symbols::h_line;
+		string out;
+		out.reserve(1 << 16);
+
+		counter concat;
+		concat.begin();
+		for (int i = 0; i < lines; i++)
+			out += Mv::to(i + 1, 5) + color + Fx::b + "CPU " + rjust(to_string(i * 7), 4) + line_symbol * 10 + Mv::r(2) + Fx::ub;
+		concat.end();
+		const string concatenated = out;
+
+		out.clear();
+		counter writer;
+		writer.begin();
+		Esc::writer w(out);
+		for (int i = 0; i < lines; i++)
+			w << Esc::to(i + 1, 5) << color << Fx::b << "CPU " << Esc::rjust(i * 7, 4) << Esc::repeat(line_symbol, 10) << Esc::r(2) << Fx::ub;
+		writer.end();
+
+		if (out != concatenated) {
+			std::cerr << "alloc: Esc::writer output differs from the concatenated lines\n";
+			std::exit(1);
+		}
+		cout << "  " << lines << " box lines: " << concat.total << " allocations concatenated, " << writer.total << " with Esc::writer\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const string spec = (argc > 1 ? argv[1] : "synthetic:cores=32,procs=1000");
+	const int frames = (argc > 2 ? std::max(1, std::stoi(argv[2])) : 50);
+
+	Term::width = 200;
+	Term::height = 60;
+	Config::check_boxes("cpu proc");
+	Theme::setTheme();
+	Draw::calcSizes();
+
+	try {
+		Backend::init(spec);
+		cout << spec << ", allocations per frame\n" << "  " << std::left << std::setw(16) << "" << std::right << std::setw(10) << "cpu" << std::setw(10) << "proc" << std::setw(10) << "html" << '\n';
+		count_draws(frames, false);
+		count_draws(frames, true);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "alloc: " << e.what() << '\n';
+		return 1;
+	}
+	count_lines(100);
+}
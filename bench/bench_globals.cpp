@@ -0,0 +1,74 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//? State normally defined by btop.cpp, btop_collect.cpp, btop_input.cpp and btop_menu.cpp, which need Win32 and aren't
+//? linked into the benchmarks, values are what those files start with before any hardware is detected
+
+#include <btop_shared.hpp>
+#include <btop_input.hpp>
+#include <btop_menu.hpp>
+
+namespace Global {
+	const vector<array<string, 2>> Banner_src;
+	const string Version = "bench";
+	atomic<bool> resized (false);
+	string overlay;
+	string clock;
+}
+
+namespace Runner {
+	atomic<bool> active (false);
+	atomic<bool> stopping (false);
+	atomic<bool> redraw (false);
+	bool pause_output = false;
+}
+
+namespace Input {
+	unordered_flat_map<string, Mouse_loc> mouse_mappings;
+}
+
+namespace Menu {
+	atomic<bool> active (false);
+	bool redraw = true;
+}
+
+namespace Tools {
+	double system_uptime() { return 0.0; }
+}
+
+namespace Cpu {
+	bool got_sensors = false, cpu_temp_only = false, has_battery = false, has_gpu = false;
+	string cpuName = "Synthetic", cpuHz;
+	tuple<int, long, string> current_bat;
+	string gpu_name, gpu_clock;
+}
+
+namespace Mem {
+	bool has_swap = false, cpu_gpu = false;
+	int disk_ios = 0;
+	int64_t totalMem = 0;
+}
+
+namespace Net {
+	string selected_iface;
+	array<uint64_t, NDcount> graph_max = {};
+}
+
+namespace Proc {
+	detail_container detailed;
+}
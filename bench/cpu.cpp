@@ -0,0 +1,126 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Times Cpu::apply_sample against the per-core aggregation it replaced at 64, 128 and 256 logical processors
+//* usage: cpu [ticks], default 2000 ticks for each core count
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <numeric>
+#include <cmath>
+
+#include <btop_shared.hpp>
+#include <btop_config.hpp>
+#include <btop_theme.hpp>
+#include <btop_draw.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+
+using std::cout, std::string, std::vector, std::max, std::clamp, std::round;
+using namespace std::chrono;
+
+namespace {
+	//? The aggregation Cpu::collect() used before the single pass with its own previous totals, only the division by zero guard is added
+	struct old_aggregation {
+		vector<long long> core_old_totals, core_old_idles;
+		array<long long, Cpu::CFcount> cpu_old = {};
+
+		void apply(Cpu::cpu_info& cpu, const Backend::cpu_sample& sample) {
+			core_old_totals.resize(Shared::coreCount, 0);
+			core_old_idles.resize(Shared::coreCount, 0);
+			cpu.core_percent.resize(Shared::coreCount);
+
+			vector<long long> idle, kernel, user, interrupt, dpc, total;
+			long long totals;
+			long long cpu_total = 0;
+
+			for (int i = 0; i < Shared::coreCount; i++) {
+				const auto& core = sample.cores[i];
+				user.push_back(core.user);
+				idle.push_back(core.idle);
+				kernel.push_back(core.kernel);
+				dpc.push_back(core.dpc);
+				interrupt.push_back(core.interrupt);
+
+				totals = 0;
+				for (auto& v : { kernel, user, dpc, interrupt, idle }) totals += v.back();
+
+				const long long calc_totals = max(1ll, totals - core_old_totals.at(i));
+				const long long calc_idles = max(0ll, idle.back() - core_old_idles.at(i));
+				core_old_totals.at(i) = totals;
+				core_old_idles.at(i) = idle.back();
+
+				cpu.core_percent.at(i).push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+				cpu_total += cpu.core_percent.at(i).back();
+				cpu.core_percent.at(i).trim(40);
+			}
+
+			vector<long long> times;
+			totals = 0;
+			for (auto& v : { kernel, user, dpc, interrupt, idle }) {
+				times.push_back(std::accumulate(v.cbegin(), v.cend(), 0));
+				totals += times.back();
+			}
+
+			const long long calc_totals = max(1ll, totals - cpu_old[Cpu::CFtotal]);
+			cpu_old[Cpu::CFtotal] = totals;
+			cpu.cpu_percent[Cpu::CFtotal].push_back(clamp(cpu_total / Shared::coreCount, 0ll, 100ll));
+			cpu.cpu_percent[Cpu::CFtotal].trim(Cpu::width * 2);
+
+			for (int field = Cpu::CFkernel; const auto& val : times) {
+				cpu.cpu_percent[field].push_back(clamp((long long)round((double)(val - cpu_old[field]) * 100 / calc_totals), 0ll, 100ll));
+				cpu_old[field] = val;
+				cpu.cpu_percent[field].trim(Cpu::width * 2);
+				field++;
+			}
+		}
+	};
+
+	template <typename F>
+	double time_per_tick(const vector<Backend::cpu_sample>& samples, F&& func) {
+		const auto start = steady_clock::now();
+		for (const auto& sample : samples) func(sample);
+		return duration<double, std::micro>(steady_clock::now() - start).count() / samples.size();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const int ticks = (argc > 1 ? std::max(1, std::stoi(argv[1])) : 2000);
+
+	Term::width = 200;
+	Term::height = 60;
+	Config::check_boxes("cpu");
+	Theme::setTheme();
+	Draw::calcSizes();
+
+	cout << std::fixed << std::setprecision(2) << "cores       old us/tick   new us/tick\n";
+	for (const size_t cores : {64, 128, 256}) {
+		Backend::init("synthetic:cores=" + std::to_string(cores) + ",procs=0");
+		vector<Backend::cpu_sample> samples(ticks);
+		for (auto& sample : samples) Backend::source->cpu(sample);
+		Shared::coreCount = cores;
+
+		Cpu::cpu_info old_cpu, new_cpu;
+		old_aggregation old;
+		const double old_us = time_per_tick(samples, [&](const auto& sample) { old.apply(old_cpu, sample); });
+		const double new_us = time_per_tick(samples, [&](const auto& sample) { Cpu::apply_sample(new_cpu, sample); });
+
+		cout << std::setw(5) << cores << std::setw(14) << old_us << std::setw(14) << new_us << "  (" << std::setprecision(1) << old_us / new_us << "x)\n" << std::setprecision(2);
+	}
+}
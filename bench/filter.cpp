@@ -0,0 +1,107 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Types a process filter one character at a time and times each keystroke with the folded search keys and narrowing in Proc::arrange()
+//* against the case insensitive scans of name, cmd, user and pid that were used before
+//* usage: filter [processes] [filter], default 10000 processes with ~300 character command lines and filter "RuntimeBroker.exe --inst"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include <btop_shared.hpp>
+#include <btop_config.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+
+using std::cout, std::string, std::vector, std::to_string;
+using namespace std::chrono;
+using namespace Tools;
+
+namespace {
+	//? The filter match Proc::collect() used before the folded search keys, marks hidden processes in <filtered> instead of
+	//? proc_info::filtered so the narrowing isn't given its results, returns the number of hidden processes
+	int old_filter(const vector<Proc::proc_info>& procs, const string& filter, vector<bool>& filtered) {
+		int filter_found = 0;
+		for (size_t i = 0; const auto& p : procs) {
+			if (not s_contains(to_string(p.pid), filter)
+			and not s_contains_ic(p.name, filter)
+			and not s_contains_ic(p.text->cmd, filter)
+			and not s_contains_ic(p.text->user, filter)) {
+				filtered[i] = true;
+				filter_found++;
+			}
+			else {
+				filtered[i] = false;
+			}
+			i++;
+		}
+		return filter_found;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const int count = (argc > 1 ? std::max(1, std::stoi(argv[1])) : 10000);
+	const string typed = (argc > 2 ? argv[2] : "RuntimeBroker.exe --inst");
+
+	Backend::init("synthetic:cores=16,procs=" + to_string(count));
+	Shared::coreCount = 16;
+	Backend::proc_list sample;
+	Backend::source->procs(sample);
+	vector<Proc::proc_info> procs;
+	Proc::apply_sample(procs, sample, false);
+
+	//? Long command lines like the ones browsers and build tools have
+	for (auto& p : procs) {
+		p.text->cmd += " --type=" + string(p.pid % 5 == 0 ? "renderer" : "utility") + " --field-trial-handle=" + to_string(p.pid * 7919)
+			+ " --lang=en-US --enable-features=" + string(220, 'x') + " --variations-seed-version --mojo-platform-channel-handle=" + to_string(p.pid);
+		Proc::update_search_key(p);
+	}
+	const auto& sorting = Config::getS("proc_sorting");
+	Proc::arrange(procs, sorting, false, "", false, false, false, true, true);
+
+	cout << procs.size() << " processes, typing \"" << typed << "\"\n" << "  filter                       shown   old us   new us\n" << std::fixed << std::setprecision(1);
+	vector<bool> old_filtered(procs.size());
+	double old_total = 0, new_total = 0;
+	for (size_t len = 1; len <= typed.size(); len++) {
+		const string filter = typed.substr(0, len);
+
+		auto start = steady_clock::now();
+		const int old_found = old_filter(procs, filter, old_filtered);
+		const double old_us = duration<double, std::micro>(steady_clock::now() - start).count();
+
+		//? Keystrokes only change the filter, so the previous match set can be narrowed
+		start = steady_clock::now();
+		Proc::arrange(procs, sorting, false, filter, false, false, true, true, false);
+		const double new_us = duration<double, std::micro>(steady_clock::now() - start).count();
+
+		for (size_t i = 0; i < procs.size(); i++) {
+			if (procs[i].filtered != old_filtered[i]) {
+				std::cerr << "filter: pid " << procs[i].pid << " is matched differently by \"" << filter << "\"\n";
+				return 1;
+			}
+		}
+
+		old_total += old_us;
+		new_total += new_us;
+		cout << "  " << std::left << std::setw(26) << ('"' + filter + '"') << std::right << std::setw(8) << (int)procs.size() - old_found
+			<< std::setw(9) << old_us << std::setw(9) << new_us << '\n';
+	}
+	cout << "  " << std::left << std::setw(34) << "average" << std::right << std::setw(9) << old_total / typed.size()
+		<< std::setw(9) << new_total / typed.size() << "  (" << old_total / new_total << "x)\n";
+}
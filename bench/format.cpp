@@ -0,0 +1,192 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Per call cost of the number, duration, time and padding formatters against the string building versions they replaced,
+//* checks that both give the same output first
+//* usage: format [calls], default 2000000 calls for each formatter
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+#include <btop_config.hpp>
+#include <btop_tools.hpp>
+
+using std::cout, std::string, std::string_view, std::to_string, std::array, std::round;
+using namespace std::chrono;
+using namespace Tools;
+
+namespace {
+	//? Tools::sec_to_dhms() before Tools::dhms()
+	string old_sec_to_dhms(size_t seconds, bool no_days, bool no_seconds) {
+		size_t days = seconds / 86400; seconds %= 86400;
+		size_t hours = seconds / 3600; seconds %= 3600;
+		size_t minutes = seconds / 60; seconds %= 60;
+		string out 	= (not no_days and days > 0 ? to_string(days) + "d " : "")
+					+ (hours < 10 ? "0" : "") + to_string(hours) + ':'
+					+ (minutes < 10 ? "0" : "") + to_string(minutes)
+					+ (not no_seconds ? ":" + string(std::cmp_less(seconds, 10) ? "0" : "") + to_string(seconds) : "");
+		return out;
+	}
+
+	//? Tools::floating_humanizer() before Tools::humanized()
+	string old_floating_humanizer(uint64_t value, const bool shorten, size_t start, const bool bit, const bool per_second) {
+		string out;
+		const size_t mult = (bit) ? 8 : 1;
+		const bool mega = Config::getB("base_10_sizes");
+		static const array<string, 11> mebiUnits_bit = {"bit", "Kib", "Mib", "Gib", "Tib", "Pib", "Eib", "Zib", "Yib", "Bib", "GEb"};
+		static const array<string, 11> mebiUnits_byte = {"Byte", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", "BiB", "GEB"};
+		static const array<string, 11> megaUnits_bit = {"bit", "Kb", "Mb", "Gb", "Tb", "Pb", "Eb", "Zb", "Yb", "Bb", "Gb"};
+		static const array<string, 11> megaUnits_byte = {"Byte", "KB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", "BB", "GB"};
+		const auto& units = (bit) ? ( mega ? megaUnits_bit : mebiUnits_bit) : ( mega ? megaUnits_byte : mebiUnits_byte);
+
+		value *= 100 * mult;
+
+		if (mega) {
+			while (value >= 100000) {
+				value /= 1000;
+				if (value < 100) {
+					out = to_string(value);
+					break;
+				}
+				start++;
+			}
+		}
+		else {
+			while (value >= 102400) {
+				value >>= 10;
+				if (value < 100) {
+					out = to_string(value);
+					break;
+				}
+				start++;
+			}
+		}
+		if (out.empty()) {
+			out = to_string(value);
+			if (not mega and out.size() == 4 and start > 0) { out.pop_back(); out.insert(2, ".");}
+			else if (out.size() == 3 and start > 0) out.insert(1, ".");
+			else if (out.size() >= 2) out.resize(out.size() - 2);
+		}
+		if (shorten) {
+			auto f_pos = out.find('.');
+			if (f_pos == 1 and out.size() > 3) out = to_string(round(stof(out) * 10) / 10).substr(0,3);
+			else if (f_pos != string::npos) out = to_string((int)round(stof(out)));
+			if (out.size() > 3) { out = to_string((int)(out[0] - '0') + 1); start++;}
+			out.push_back(units[start][0]);
+		}
+		else out += " " + units[start];
+
+		if (per_second) out += (bit) ? "ps" : "/s";
+		return out;
+	}
+
+	//? Tools::strf_time() before formatting with strftime
+	string old_strf_time(const string& strf) {
+		const time_t in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+		std::stringstream ss;
+		struct tm* bt = localtime(&in_time_t);
+		ss << std::put_time(bt, strf.c_str());
+		return ss.str();
+	}
+
+	//? Keeps the results alive so the calls aren't optimized away
+	volatile size_t sink = 0;
+
+	template <typename F>
+	double ns_per_call(const int calls, F&& func) {
+		size_t total = 0;
+		const auto start = steady_clock::now();
+		for (int i = 0; i < calls; i++) total += func(i);
+		const double ns = duration<double, std::nano>(steady_clock::now() - start).count();
+		sink = total;
+		return ns / calls;
+	}
+
+	void report(const string& name, const double old_ns, const double new_ns) {
+		cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(9) << old_ns << std::setw(9) << new_ns << "  (" << old_ns / new_ns << "x)\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const int calls = (argc > 1 ? std::max(1, std::stoi(argv[1])) : 2000000);
+
+	//? Same output as the old versions for both unit bases, all option combinations and values across the whole range
+	std::mt19937_64 rng(1);
+	size_t checked = 0;
+	for (const bool mega : {false, true}) {
+		Config::set("base_10_sizes", mega);
+		for (int i = 0; i < 500000; i++) {
+			uint64_t value = (i < 100000 ? i : rng() >> (rng() % 64));
+			const bool shorten = rng() & 1, bit = rng() & 1, per_second = rng() & 1;
+			const size_t start = rng() % 3;
+			if (bit and (value >> 40) != 0) value >>= 8;
+			if (humanized(value, shorten, start, bit, per_second) != string_view(old_floating_humanizer(value, shorten, start, bit, per_second))) {
+				std::cerr << "format: humanized(" << value << ", " << shorten << ", " << start << ", " << bit << ", " << per_second << ") differs\n";
+				return 1;
+			}
+			checked++;
+		}
+	}
+	Config::set("base_10_sizes", false);
+	for (size_t seconds = 0; seconds < 4000000; seconds += 37) {
+		for (int flags = 0; flags < 4; flags++, checked++) {
+			if (dhms(seconds, flags & 1, flags & 2) != string_view(old_sec_to_dhms(seconds, flags & 1, flags & 2))) {
+				std::cerr << "format: dhms(" << seconds << ") differs\n";
+				return 1;
+			}
+		}
+	}
+	const array<string, 3> texts = {"btop", "/usr/lib/firefox/firefox -contentproc -childID 12", "räksmörgås ÅÄÖ"};
+	for (const auto& text : texts) {
+		for (int width = -2; width < 60; width++) {
+			for (const bool utf : {false, true}) {
+				string out;
+				Esc::writer(out) << Esc::ljust(text, width, utf) << Esc::rjust(text, width, utf) << Esc::cjust(text, width, utf);
+				if (out != ljust(text, width, utf) + rjust(text, width, utf) + cjust(text, width, utf)) {
+					std::cerr << "format: Esc justify of \"" << text << "\" to " << width << " differs\n";
+					return 1;
+				}
+				checked++;
+			}
+		}
+	}
+	cout << checked << " cases identical to the old versions\n\n" << "  " << std::left << std::setw(26) << "ns/call" << std::right << std::setw(9) << "old" << std::setw(9) << "new" << '\n';
+
+	report("floating_humanizer", ns_per_call(calls, [](int i) { return old_floating_humanizer((uint64_t)i * 123457, false, 0, false, false).size(); }),
+		ns_per_call(calls, [](int i) { return humanized((uint64_t)i * 123457, false, 0, false, false).size(); }));
+	report("floating_humanizer short", ns_per_call(calls, [](int i) { return old_floating_humanizer((uint64_t)i * 123457, true, 0, true, true).size(); }),
+		ns_per_call(calls, [](int i) { return humanized((uint64_t)i * 123457, true, 0, true, true).size(); }));
+	report("sec_to_dhms", ns_per_call(calls, [](int i) { return old_sec_to_dhms((size_t)i * 97, false, false).size(); }),
+		ns_per_call(calls, [](int i) { return dhms((size_t)i * 97, false, false).size(); }));
+
+	//? Padding into a reused line buffer as Proc::draw() does
+	string line;
+	report("rjust number", ns_per_call(calls, [&](int i) { line.clear(); line += rjust(to_string(i), 7); return line.size(); }),
+		ns_per_call(calls, [&](int i) { line.clear(); Esc::writer(line) << Esc::rjust(i, 7); return line.size(); }));
+	report("ljust utf", ns_per_call(calls, [&](int i) { line.clear(); line += ljust(texts[i % 3], 20, true); return line.size(); }),
+		ns_per_call(calls, [&](int i) { line.clear(); Esc::writer(line) << Esc::ljust(texts[i % 3], 20, true); return line.size(); }));
+
+	const string clock_format = "%X";
+	report("strf_time", ns_per_call(calls / 10, [&](int) { return old_strf_time(clock_format).size(); }),
+		ns_per_call(calls / 10, [&](int) { return strf_time(clock_format).size(); }));
+}
@@ -0,0 +1,122 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Runs a collector backend through the portable parts of Cpu and Proc collect, sort, tree and draw, and prints the average time per tick
+//* usage: pipeline [backend spec] [ticks], default "synthetic:cores=256,procs=50000" and 20 ticks
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include <btop_shared.hpp>
+#include <btop_config.hpp>
+#include <btop_theme.hpp>
+#include <btop_draw.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+
+using std::cout, std::string, std::vector;
+using namespace std::chrono;
+
+namespace {
+	enum Stages { Sample, CpuApply, CpuDraw, ProcApply, Arrange, ProcDraw, StageCount };
+	const array<string, StageCount> stage_names = { "sample", "cpu apply", "cpu draw", "proc apply", "sort/tree", "proc draw" };
+
+	struct timer {
+		array<double, StageCount> total = {};
+		steady_clock::time_point last = steady_clock::now();
+		void lap(const Stages stage) {
+			const auto now = steady_clock::now();
+			total[stage] += duration<double, std::micro>(now - last).count();
+			last = now;
+		}
+	};
+
+	void run(const string& spec, const int ticks, const bool tree) {
+		Backend::init(spec);
+		Config::set("proc_tree", tree);
+		const auto& sorting = Config::getS("proc_sorting");
+		const auto& reverse = Config::getB("proc_reversed");
+		const auto& filter = Config::getS("proc_filter");
+		const auto& per_core = Config::getB("proc_per_core");
+
+		Backend::cpu_sample cpu_sample;
+		Backend::mem_sample mem_sample;
+		Backend::proc_list proc_sample;
+		Cpu::cpu_info cpu;
+		vector<Proc::proc_info> procs;
+		Proc::display_order.clear();
+		timer t;
+		array<double, StageCount> first = {};
+
+		for (int i = 0; i <= ticks; i++) {
+			t.last = steady_clock::now();
+			Backend::source->cpu(cpu_sample);
+			Backend::source->mem(mem_sample);
+			Backend::source->procs(proc_sample);
+			t.lap(Sample);
+			Shared::coreCount = cpu_sample.cores.size();
+			Mem::totalMem = mem_sample.total;
+			Cpu::apply_sample(cpu, cpu_sample);
+			t.lap(CpuApply);
+			Cpu::draw(cpu, i == 0);
+			t.lap(CpuDraw);
+			Proc::apply_sample(procs, proc_sample, per_core);
+			t.lap(ProcApply);
+			Proc::arrange(procs, sorting, reverse, filter, tree, false, false, true, i == 0);
+			t.lap(Arrange);
+			Proc::draw(procs, i == 0);
+			t.lap(ProcDraw);
+
+			//? First tick fills all the caches and is reported on its own
+			if (i == 0) {
+				first = t.total;
+				t.total = {};
+			}
+		}
+
+		cout << spec << (tree ? ", tree" : ", flat") << ": " << Proc::numpids << " processes, " << Shared::coreCount << " cores\n";
+		double sum = 0;
+		for (int i = 0; i < StageCount; i++) {
+			cout << "  " << std::left << std::setw(12) << stage_names[i] << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(10) << first[i] << " us first" << std::setw(10) << t.total[i] / ticks << " us/tick\n";
+			sum += t.total[i] / ticks;
+		}
+		cout << "  " << std::left << std::setw(12) << "total" << std::right << std::setw(29) << sum << " us/tick\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const string spec = (argc > 1 ? argv[1] : "synthetic:cores=256,procs=50000");
+	const int ticks = (argc > 2 ? std::max(1, std::stoi(argv[2])) : 20);
+
+	Term::width = 200;
+	Term::height = 60;
+	Config::check_boxes("cpu proc");
+	Theme::setTheme();
+	Draw::calcSizes();
+
+	try {
+		run(spec, ticks, false);
+		run(spec, ticks, true);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "pipeline: " << e.what() << '\n';
+		return 1;
+	}
+}
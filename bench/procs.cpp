@@ -0,0 +1,119 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Times Proc::apply_sample with its pid index against the linear pid lookups and dead process removal Proc::collect() used before
+//* usage: procs [processes] [ticks], default 10000 processes and 20 ticks with 1% of the processes replaced every tick
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <ranges>
+#include <cmath>
+
+#include <btop_shared.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+
+using std::cout, std::string, std::vector, std::max, std::clamp, std::round;
+using namespace std::chrono;
+namespace rng = std::ranges;
+
+namespace {
+	//? Proc::apply_sample() with the table maintenance Proc::collect() had before the pid index
+	void old_apply_sample(vector<Proc::proc_info>& procs, Backend::proc_list& sample) {
+		static vector<size_t> found;
+		static uint64_t old_cputimes = 0;
+		found.clear();
+
+		for (auto& s : sample.procs) {
+			found.push_back(s.pid);
+
+			//? Check if pid already exists in current_procs
+			auto find_old = rng::find(procs, s.pid, &Proc::proc_info::pid);
+			bool no_cache = false;
+			if (find_old == procs.end()) {
+				procs.push_back({.pid = s.pid});
+				find_old = procs.end() - 1;
+				no_cache = true;
+			}
+			else if (find_old->created != s.created) {
+				*find_old = {.pid = s.pid};
+				no_cache = true;
+			}
+
+			auto& new_proc = *find_old;
+			if (no_cache) {
+				new_proc.created = new_proc.cpu_s = s.created;
+				new_proc.ppid = s.ppid;
+				new_proc.name = std::move(s.name);
+				auto& text = *new_proc.text;
+				text.cmd = std::move(s.cmd);
+				text.user = std::move(s.user);
+				if (text.cmd.empty()) text.cmd = new_proc.name;
+				if (text.user.empty()) text.user = "******";
+				Proc::update_search_key(new_proc);
+			}
+			new_proc.threads = s.threads;
+			new_proc.mem = s.mem;
+
+			if (new_proc.cpu_t == 0) new_proc.cpu_t = s.cpu_t;
+			new_proc.cpu_p = clamp(round(100 * (s.cpu_t - new_proc.cpu_t) / max((uint64_t)1, sample.cpu_total - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+			new_proc.cpu_c = (double)s.cpu_t / max((uint64_t)1, sample.systime - new_proc.cpu_s);
+			new_proc.cpu_t = s.cpu_t;
+		}
+
+		//? Clear dead processes from current_procs
+		auto eraser = rng::remove_if(procs, [&](const auto& element){ return not Tools::v_contains(found, element.pid); });
+		procs.erase(eraser.begin(), eraser.end());
+		old_cputimes = sample.cpu_total;
+	}
+
+	template <typename F>
+	double ms_per_tick(const vector<Backend::proc_list>& samples, F&& func) {
+		//? Samples are copied before timing since both versions move the strings out of new processes
+		auto copies = samples;
+		const auto start = steady_clock::now();
+		for (auto& sample : copies) func(sample);
+		return duration<double, std::milli>(steady_clock::now() - start).count() / samples.size();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const int count = (argc > 1 ? std::max(1, std::stoi(argv[1])) : 10000);
+	const int ticks = (argc > 2 ? std::max(1, std::stoi(argv[2])) : 20);
+
+	Backend::init("synthetic:cores=16,churn=0.01,procs=" + std::to_string(count));
+	Shared::coreCount = 16;
+	vector<Backend::proc_list> samples(ticks);
+	for (auto& sample : samples) Backend::source->procs(sample);
+
+	vector<Proc::proc_info> old_procs, new_procs;
+	const double old_ms = ms_per_tick(samples, [&](auto& sample) { old_apply_sample(old_procs, sample); });
+	const double new_ms = ms_per_tick(samples, [&](auto& sample) { Proc::apply_sample(new_procs, sample, false); });
+
+	//? Both end with the same processes in the same order since dead entries are removed the same way
+	if (old_procs.size() != new_procs.size()
+	or not rng::equal(old_procs, new_procs, [](const auto& a, const auto& b) { return a.pid == b.pid and a.cpu_p == b.cpu_p and a.mem == b.mem; })) {
+		std::cerr << "procs: process tables differ after " << ticks << " ticks\n";
+		return 1;
+	}
+
+	cout << new_procs.size() << " processes, " << ticks << " ticks, identical tables\n" << std::fixed << std::setprecision(2)
+		<< "  linear lookups " << std::setw(10) << old_ms << " ms/tick\n"
+		<< "  pid index      " << std::setw(10) << new_ms << " ms/tick  (" << std::setprecision(1) << old_ms / new_ms << "x)\n";
+}
@@ -0,0 +1,121 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+//* Compares Fx::uncolor against the std::regex version it replaced on full frames, checks that both give the same output
+//* usage: uncolor [backend spec] [frames], frames are drawn from the cpu and proc boxes, default "synthetic:cores=32,procs=1000" and 20 frames
+//* Samples recorded with --record can be used with "replay:<file>"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <regex>
+
+#include <btop_shared.hpp>
+#include <btop_config.hpp>
+#include <btop_theme.hpp>
+#include <btop_draw.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+
+using std::cout, std::string, std::vector;
+using namespace std::chrono;
+
+namespace {
+	//? The implementation Fx::uncolor had before the single pass scanner
+	const std::regex color_regex("\033\\[\\d+;?\\d?;?\\d*;?\\d*;?\\d*(m){1}");
+	string regex_uncolor(const string& s) { return std::regex_replace(s, color_regex, ""); }
+
+	//* Draw <count> frames from the active backend the same way Runner joins the box layers before the menu overlay uncolors them
+	vector<string> render_frames(const int count) {
+		Backend::cpu_sample cpu_sample;
+		Backend::mem_sample mem_sample;
+		Backend::proc_list proc_sample;
+		Cpu::cpu_info cpu;
+		vector<Proc::proc_info> procs;
+		vector<string> frames;
+
+		for (int i = 0; i < count; i++) {
+			Backend::source->cpu(cpu_sample);
+			Backend::source->mem(mem_sample);
+			Backend::source->procs(proc_sample);
+			Shared::coreCount = cpu_sample.cores.size();
+			Mem::totalMem = mem_sample.total;
+			Cpu::apply_sample(cpu, cpu_sample);
+			Proc::apply_sample(procs, proc_sample, false);
+			Proc::arrange(procs, Config::getS("proc_sorting"), false, "", false, false, false, true, i == 0);
+
+			string frame;
+			for (const auto& box : {Cpu::draw(cpu, true), Proc::draw(procs, true)}) {
+				frame.append(box.chrome);
+				frame.append(box.content);
+			}
+			frames.push_back(std::move(frame));
+		}
+		return frames;
+	}
+
+	//? Keeps the results alive so the calls aren't optimized away
+	volatile size_t sink = 0;
+
+	template <typename F>
+	double time_per_frame(const vector<string>& frames, const int reps, F&& func) {
+		const auto start = steady_clock::now();
+		for (int r = 0; r < reps; r++) {
+			for (const auto& frame : frames) sink = sink + func(frame).size();
+		}
+		const double us = duration<double, std::micro>(steady_clock::now() - start).count();
+		return us / (reps * frames.size());
+	}
+}
+
+int main(int argc, char* argv[]) {
+	const string spec = (argc > 1 ? argv[1] : "synthetic:cores=32,procs=1000");
+	const int count = (argc > 2 ? std::max(1, std::stoi(argv[2])) : 20);
+
+	Term::width = 200;
+	Term::height = 60;
+	Config::check_boxes("cpu proc");
+	Theme::setTheme();
+	Draw::calcSizes();
+
+	vector<string> frames;
+	try {
+		Backend::init(spec);
+		frames = render_frames(count);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "uncolor: " << e.what() << '\n';
+		return 1;
+	}
+
+	size_t bytes = 0;
+	for (size_t i = 0; i < frames.size(); i++) {
+		bytes += frames[i].size();
+		if (Fx::uncolor(frames[i]) != regex_uncolor(frames[i])) {
+			std::cerr << "uncolor: output differs from the regex version on frame " << i << '\n';
+			return 1;
+		}
+	}
+
+	const double scan_us = time_per_frame(frames, 20, [](const string& s) { return Fx::uncolor(s); });
+	const double regex_us = time_per_frame(frames, 1, regex_uncolor);
+
+	cout << frames.size() << " frames of " << bytes / frames.size() << " bytes on average, output identical\n" << std::fixed << std::setprecision(1)
+		<< "  regex   " << std::setw(10) << regex_us << " us/frame\n"
+		<< "  scanner " << std::setw(10) << scan_us << " us/frame  (" << regex_us / scan_us << "x)\n";
+}
@@ -38,6 +38,7 @@ tab-size = 4
 #include <btop_draw.hpp>
 #include <btop_menu.hpp>
 #include <btop_websocket.hpp>
+#include <btop_backend.hpp>
 
 using std::string, std::string_view, std::vector, std::atomic, std::endl, std::cout, std::min, std::flush, std::endl;
 using std::string_literals::operator""s, std::to_string;
@@ -80,7 +81,10 @@ namespace Global {
 
 	bool arg_tty = false;
 	bool arg_low_color = false;
+	bool arg_headless = false;
 	int arg_preset = -1;
+	string arg_backend;
+	string arg_record;
 }
 
 //* A simple argument parser
@@ -88,7 +92,7 @@ void argumentParser(const int& argc, char **argv) {
 	for(int i = 1; i < argc; i++) {
 		const string argument = argv[i];
 		if (is_in(argument, "-h", "--help")) {
-			cout 	<< "usage: btop [-h] [-v] [-/+t] [-p <id>] [--utf-force] [--debug]\n\n"
+			cout 	<< "usage: btop [-h] [-v] [-/+t] [-p <id>] [--headless] [--backend <spec>] [--record <file>] [--utf-force] [--debug]\n\n"
 					<< "optional arguments:\n"
 					<< "  -h, --help            show this help message and exit\n"
 					<< "  -v, --version         show version info and exit\n"
@@ -96,6 +100,11 @@ void argumentParser(const int& argc, char **argv) {
 					<< "  -t, --tty_on          force (ON) tty mode, max 16 colors and tty friendly graph symbols\n"
 					<< "  +t, --tty_off         force (OFF) tty mode\n"
 					<< "  -p, --preset <id>     start with preset, integer value between 0-9\n"
+					<< "  --headless            run without a console, frames are only sent to websocket clients\n"
+					<< "                        terminal size is set by <headless_width> and <headless_height>\n"
+					<< "  --backend <spec>      collect from another source than the system, \"synthetic[:cores=N,procs=N,\n"
+					<< "                        churn=F,disks=N,ifaces=N,seed=N]\", \"replay:<file>\" or \"linux\" (/proc)\n"
+					<< "  --record <file>       write every collected sample to <file> for use with --backend replay:<file>\n"
 					<< "  --debug               start in DEBUG mode: shows microsecond timer for information collect\n"
 					<< "                        and screen draw functions and sets loglevel to DEBUG\n"
 					<< endl;
@@ -129,6 +138,15 @@ void argumentParser(const int& argc, char **argv) {
 				exit(1);
 			}
 		}
+		else if (argument == "--headless")
+			Global::arg_headless = true;
+		else if (is_in(argument, "--backend", "--record")) {
+			if (++i >= argc) {
+				cout << "ERROR: " << argument << " option needs an argument." << endl;
+				exit(1);
+			}
+			(argument == "--backend" ? Global::arg_backend : Global::arg_record) = argv[i];
+		}
 		else if (argument == "--debug")
 			Global::debug = true;
 		else {
@@ -157,7 +175,7 @@ void term_resize(bool force) {
 	Global::resized = true;
 	if (Runner::active) Runner::stop();
 	Term::refresh();
-	Config::unlock();
+	Config::publish();
 
 	auto boxes = Config::getS("shown_boxes");
 	auto min_size = Term::get_min_size(boxes);
@@ -247,13 +265,20 @@ namespace Runner {
 	atomic<bool> stopping (false);
 	atomic<bool> waiting (false);
 	atomic<bool> redraw (false);
+	atomic<bool> activity (false);
+
+	//? Time from the start of a collect to the next one, set by the runner thread when a collect finishes
+	atomic<uint64_t> interval (0);
 
 	std::binary_semaphore do_work(0);
 	inline void thread_wait() { do_work.acquire(); }
 	inline void thread_trigger() { do_work.release(); }
 
 
-	string output;
+	//? Views into the box output buffers and other persistent strings that make up the current frame
+	vector<string_view> frame;
+	string uncolored;
+	string debug_out;
 	string empty_bg;
 	bool pause_output = false;
 
@@ -276,6 +301,7 @@ namespace Runner {
 		bool no_update;
 		bool force_redraw;
 		bool background_update;
+		bool adaptive;
 		string overlay;
 		string clock;
 	};
@@ -299,8 +325,50 @@ namespace Runner {
 		}
 	}
 
+	//* Sets <activity> if <value> changed by at least <adaptive_threshold> since the last sample of metric <index>
+	void check_activity(const size_t index, const long long value) {
+		static array<long long, 2> last = {-1, -1};
+		if (last.at(index) >= 0 and std::abs(value - last.at(index)) >= Config::getI("adaptive_threshold")) activity = true;
+		last.at(index) = value;
+	}
+
+	//* Returns the time until next update, grows by half per idle cycle up to <adaptive_max_ms> and snaps back to <update_ms> on any activity,
+	//* called by the runner thread when a collect finishes so activity seen by that collect is counted for it
+	uint64_t next_interval(const uint64_t update_ms, const uint64_t interval) {
+		const bool changed = activity.exchange(false);
+		const bool joined = WebSocket::client_joined.exchange(false);
+		if (changed or joined or not Config::getB("adaptive_update") or WebSocket::active_clients > 0) return update_ms;
+		const uint64_t max_ms = std::max((uint64_t)Config::getI("adaptive_max_ms"), update_ms);
+		return min(std::max(interval, update_ms) * 3 / 2, max_ms);
+	}
+
+	//* Time from the start of the last collect to the next one, <update_ms> if there was activity since that collect finished
+	uint64_t current_interval(const uint64_t update_ms) {
+		if (activity or WebSocket::client_joined) return update_ms;
+		return std::max(update_ms, interval.load());
+	}
+
+	//* Writes all parts of a frame to the console with a single flush, without concatenating them first
+	void write_frame(const vector<string_view>& views) {
+		cout << Term::sync_start;
+		for (const auto& view : views) cout.write(view.data(), view.size());
+		cout << Term::hide_cursor << Term::sync_end << flush;
+	}
+
+	inline bool frame_empty(const vector<string_view>& views) {
+		return rng::all_of(views, [](const string_view& view) { return view.empty(); });
+	}
+
+	//* Adds the layers of a box to the frame, chrome is only set on redraw cycles and goes first so content is drawn on top of it
+	inline void push_layers(const Draw::layers& box) {
+		if (not box.chrome.empty()) frame.push_back(box.chrome);
+		frame.push_back(box.content);
+	}
+
 	//? ------------------------------- Secondary thread: async launcher and drawing ----------------------------------
 	void _runner() {
+		//? Read the config snapshot taken by Config::acquire() instead of the values the main thread edits
+		Config::current = &Config::snapshot;
 
 		//* ----------------------------------------------- THREAD LOOP -----------------------------------------------
 		while (not Global::quitting) {
@@ -320,6 +388,7 @@ namespace Runner {
 			//? Atomic lock used for blocking non thread-safe actions in main thread
 			atomic_lock lck(active);
 
+			Config::acquire();
 			auto& conf = current_conf;
 
 			//! DEBUG stats
@@ -329,7 +398,7 @@ namespace Runner {
 				debug_times["total"] = {0, 0};
 			}
 
-			output.clear();
+			frame.clear();
 
 			//* Run collection and draw functions for all boxes
 			try {
@@ -340,11 +409,13 @@ namespace Runner {
 
 						//? Start collect
 						Cpu::cpu_info cpu = Cpu::collect(conf.no_update);
+						if (conf.adaptive and not conf.no_update and not cpu.cpu_percent[Cpu::CFtotal].empty())
+							check_activity(0, cpu.cpu_percent[Cpu::CFtotal].back());
 
 						if (Global::debug) debug_timer("cpu", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Cpu::draw(cpu, conf.force_redraw, conf.no_update);
+						if (not pause_output) push_layers(Cpu::draw(cpu, conf.force_redraw, conf.no_update));
 
 						if (Global::debug) debug_timer("cpu", draw_done);
 					}
@@ -360,11 +431,13 @@ namespace Runner {
 
 						//? Start collect
 						auto mem = Mem::collect(conf.no_update);
+						if (conf.adaptive and not conf.no_update and not mem.percent[Mem::MSused].empty())
+							check_activity(1, mem.percent[Mem::MSused].back());
 
 						if (Global::debug) debug_timer("mem", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Mem::draw(mem, conf.force_redraw, conf.no_update);
+						if (not pause_output) push_layers(Mem::draw(mem, conf.force_redraw, conf.no_update));
 
 						if (Global::debug) debug_timer("mem", draw_done);
 					}
@@ -384,7 +457,7 @@ namespace Runner {
 						if (Global::debug) debug_timer("net", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Net::draw(net, conf.force_redraw, conf.no_update);
+						if (not pause_output) push_layers(Net::draw(net, conf.force_redraw, conf.no_update));
 
 						if (Global::debug) debug_timer("net", draw_done);
 					}
@@ -404,7 +477,7 @@ namespace Runner {
 						if (Global::debug) debug_timer("proc", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Proc::draw(proc, conf.force_redraw, conf.no_update);
+						if (not pause_output) push_layers(Proc::draw(proc, conf.force_redraw, conf.no_update));
 
 						if (Global::debug) debug_timer("proc", draw_done);
 					}
@@ -420,6 +493,11 @@ namespace Runner {
 				stopping = true;
 			}
 
+			//? Stretch or reset the update interval from what this collect saw
+			if (not conf.no_update) interval = next_interval(Config::getI("update_ms"), interval);
+
+			Config::report();
+
 			if (stopping) {
 				continue;
 			}
@@ -429,12 +507,12 @@ namespace Runner {
 				redraw = false;
 			}
 
-			if (not pause_output) output += conf.clock;
+			if (not pause_output) frame.push_back(conf.clock);
 			if (not conf.overlay.empty() and not conf.background_update) pause_output = true;
-			if (output.empty() and not pause_output) {
+			if (frame_empty(frame) and not pause_output) {
 				if (empty_bg.empty()) {
 					const int x = Term::width / 2 - 10, y = Term::height / 2 - 10;
-					output += Term::clear;
+					frame.push_back(Term::clear);
 					empty_bg += Draw::banner_gen(y, 0, true)
 						+ Mv::to(y+6, x) + Theme::c("title") + Fx::b + "No boxes shown!"
 						+ Mv::to(y+8, x) + Theme::c("hi_fg") + "1" + Theme::c("main_fg") + " | Show CPU box"
@@ -444,35 +522,43 @@ namespace Runner {
 						+ Mv::to(y+12, x-2) + Theme::c("hi_fg") + "esc" + Theme::c("main_fg") + " | Show menu"
 						+ Mv::to(y+13, x) + Theme::c("hi_fg") + "q" + Theme::c("main_fg") + " | Quit";
 				}
-				output += empty_bg;
+				frame.push_back(empty_bg);
 			}
 
 			//! DEBUG stats -->
 			if (Global::debug and not Menu::active) {
-				output += debug_bg + Theme::c("title") + Fx::b + ljust(" Box", 9) + ljust("Collect us", 12, true) + ljust("Draw us", 9, true) + Theme::c("main_fg") + Fx::ub;
+				debug_out = debug_bg + Theme::c("title") + Fx::b + ljust(" Box", 9) + ljust("Collect us", 12, true) + ljust("Draw us", 9, true) + Theme::c("main_fg") + Fx::ub;
 				for (const string name : {"cpu", "mem", "net", "proc", "total"}) {
 					if (not debug_times.contains(name)) debug_times[name] = {0,0};
 					const auto& [time_collect, time_draw] = debug_times.at(name);
-					if (name == "total") output += Fx::b;
-					output += Mv::l(29) + Mv::d(1) + ljust(name, 8) + ljust(to_string(time_collect), 12) + ljust(to_string(time_draw), 9);
+					if (name == "total") debug_out += Fx::b;
+					debug_out += Mv::l(29) + Mv::d(1) + ljust(name, 8) + ljust(to_string(time_collect), 12) + ljust(to_string(time_draw), 9);
 				}
-				output += Mv::l(29) + Mv::d(1) + ljust("*WMI", 8) + ljust(to_string(Proc::WMItimer), 12) + ljust("0", 9);
+				debug_out += Mv::l(29) + Mv::d(1) + ljust("*WMI", 8) + ljust(to_string(Proc::WMItimer), 12) + ljust("0", 9);
 			#ifdef LHM_Enabled
-				output += Mv::l(29) + Mv::d(1) + ljust("*LHM", 8) + ljust(to_string(Cpu::OHMRTimer), 12) + ljust("0", 9);
+				debug_out += Mv::l(29) + Mv::d(1) + ljust("*LHM", 8) + ljust(to_string(Cpu::OHMRTimer), 12) + ljust("0", 9);
 			#endif
+				frame.push_back(debug_out);
 			}
 
 			//? If overlay isn't empty, print output without color and then print overlay on top
-			string final_output = conf.overlay.empty()
-					? output
-					: (output.empty() ? "" : Fx::ub + Theme::c("inactive_fg") + Fx::uncolor(output)) + conf.overlay;
-			
-			cout << Term::sync_start << final_output << Term::hide_cursor << Term::sync_end << flush;
-			
+			if (not conf.overlay.empty()) {
+				uncolored.clear();
+				for (const auto& view : frame) uncolored += view;
+				frame.clear();
+				if (not uncolored.empty()) {
+					uncolored = Fx::uncolor(std::move(uncolored));
+					frame.insert(frame.end(), {Fx::ub, Theme::c("inactive_fg"), uncolored});
+				}
+				frame.push_back(conf.overlay);
+			}
+
+			if (not Global::arg_headless) write_frame(frame);
+
 			//? Send output to WebSocket clients if enabled
 			try {
-				if (Config::getB("enable_websocket") && !final_output.empty()) {
-					std::string html_frame = WebSocket::processToResoniteHTML(final_output);
+				if (Config::getB("enable_websocket") && not frame_empty(frame)) {
+					std::string html_frame = WebSocket::processToResoniteHTML(frame);
 					WebSocket::broadcast(html_frame);
 				}
 			} catch (const std::exception& e) {
@@ -484,7 +570,7 @@ namespace Runner {
 	}
 	//? ------------------------------------------ Secondary thread end -----------------------------------------------
 
-	//* Runs collect and draw in a secondary thread, unlocks and locks config to update cached values
+	//* Runs collect and draw in a secondary thread, publishes config changes for the runner to pick up
 	void run(const string& box, const bool no_update, const bool force_redraw) {
 		atomic_wait_for(active, true, 5000);
 		static int stall_count = 0;
@@ -503,19 +589,19 @@ namespace Runner {
 		if (stopping or Global::resized) return;
 
 		if (box == "overlay") {
-			cout << Term::sync_start << Global::overlay << Term::sync_end << flush;
+			if (not Global::arg_headless) cout << Term::sync_start << Global::overlay << Term::sync_end << flush;
 		}
 		else if (box == "clock") {
-			cout << Term::sync_start << Global::clock << Term::sync_end << flush;
+			if (not Global::arg_headless) cout << Term::sync_start << Global::clock << Term::sync_end << flush;
 		}
 		else {
-			Config::unlock();
-			Config::lock();
+			Config::publish();
 
 			current_conf = {
 				(box == "all" ? Config::current_boxes : vector{box}),
 				no_update, force_redraw,
 				(not Config::getB("tty_mode") and Config::getB("background_update")),
+				Config::getB("adaptive_update"),
 				Global::overlay,
 				Global::clock
 			};
@@ -553,7 +639,7 @@ int main(int argc, char **argv) {
 
 	SetConsoleCtrlHandler(CtrlHandler, TRUE);
 
-	SetConsoleTitleA("btop4win++");
+	if (not Global::arg_headless) SetConsoleTitleA("btop4win++");
 
 	//? Setup paths for config, log and themes
 	wchar_t self_path[FILENAME_MAX] = { 0 };
@@ -583,8 +669,15 @@ int main(int argc, char **argv) {
 	}
 	
 
-	//? Initialize terminal and set options
-	if (not Term::init()) {
+	//? Initialize terminal and set options, headless mode uses a virtual terminal size from config instead
+	if (Global::arg_headless) {
+		Term::width = Config::getI("headless_width");
+		Term::height = Config::getI("headless_height");
+		Logger::info("Starting in headless mode with a " + to_string(Term::width) + "x" + to_string(Term::height) + " virtual terminal");
+		if (not Config::getB("enable_websocket"))
+			Logger::warning("Headless mode started with enable_websocket=False, no output will be sent anywhere!");
+	}
+	else if (not Term::init()) {
 		Global::exit_error_msg = "No tty detected!\nbtop4win needs an interactive shell to run.";
 		clean_quit(1);
 	}
@@ -604,6 +697,8 @@ int main(int argc, char **argv) {
 
 	//? Collector init and error check
 	try {
+		if (not Global::arg_backend.empty()) Backend::init(Global::arg_backend);
+		if (not Global::arg_record.empty()) Backend::record(Global::arg_record);
 		Shared::init();
 	}
 	catch (const std::exception& e) {
@@ -652,7 +747,12 @@ int main(int argc, char **argv) {
 
 	{
 		const auto [x, y] = Term::get_min_size(Config::getS("shown_boxes"));
-		if (Term::height < y or Term::width < x) {
+		if (Global::arg_headless and (Term::height < y or Term::width < x)) {
+			Global::exit_error_msg = "Headless terminal size too small for current config, needs at least width = "
+				+ to_string(x) + " and height = " + to_string(y) + ".";
+			clean_quit(1);
+		}
+		else if (Term::height < y or Term::width < x) {
 			term_resize(true);
 			Global::resized = false;
 			Input::interrupt = false;
@@ -663,13 +763,14 @@ int main(int argc, char **argv) {
 	Draw::calcSizes();
 
 	//? Print out box outlines
-	cout << Term::sync_start << Cpu::box << Mem::box << Net::box << Proc::box << Term::sync_end << flush;
+	if (not Global::arg_headless) cout << Term::sync_start << Cpu::box << Mem::box << Net::box << Proc::box << Term::sync_end << flush;
 
 
 	//? ------------------------------------------------ MAIN LOOP ----------------------------------------------------
 
 	uint64_t update_ms = Config::getI("update_ms");
-	auto future_time = time_ms();
+	auto cycle_start = time_ms();
+	auto future_time = cycle_start;
 
 	try {
 		while (not true not_eq not false) {
@@ -678,7 +779,7 @@ int main(int argc, char **argv) {
 			else if (Global::should_quit) clean_quit(0);
 
 			//? Make sure terminal size hasn't changed (in case of SIGWINCH not working properly)
-			term_resize(Global::resized);
+			if (not Global::arg_headless) term_resize(Global::resized);
 
 			//? Trigger secondary thread to redraw if terminal has been resized
 			if (Global::resized) {
@@ -691,31 +792,46 @@ int main(int argc, char **argv) {
 			}
 
 			//? Update clock if needed
-			if (Draw::update_clock() and not Menu::active) {
+			if (Draw::update_clock() and not Menu::active and not Global::arg_headless) {
 				Runner::run("clock");
 			}
 
-			//? Start secondary collect & draw thread at the interval set by <update_ms> config value
+			//? Start secondary collect & draw thread at the interval set by <update_ms> config value, stretched when idle if <adaptive_update> is set
 			if (time_ms() >= future_time and not Global::resized) {
+				cycle_start = time_ms();
 				Runner::run("all");
 				update_ms = Config::getI("update_ms");
-				future_time = time_ms() + update_ms;
+				future_time = cycle_start + Runner::current_interval(update_ms);
 			}
 
 			//? Loop over input polling and input action processing
 			for (auto current_time = time_ms(); current_time < future_time; current_time = time_ms()) {
+				const uint64_t interval = Runner::current_interval(update_ms);
 
 				//? Check for external clock changes and for changes to the update timer
 				if (std::cmp_not_equal(update_ms, Config::getI("update_ms"))) {
-					update_ms = Config::getI("update_ms");
-					future_time = time_ms() + update_ms;
+					update_ms = Runner::interval = Config::getI("update_ms");
+					cycle_start = time_ms();
+					future_time = cycle_start + update_ms;
 				}
-				else if (future_time - current_time > update_ms)
+				else if (current_time < cycle_start)
 					future_time = current_time;
 
+				//? Follow the interval set when the last collect finished, activity or a new websocket client since then
+				//? moves the next collect back to <update_ms> after the last one instead of collecting right away
+				else if (cycle_start + interval != future_time)
+					future_time = cycle_start + interval;
+
+				//? No console input in headless mode, just wait for the next update
+				else if (Global::arg_headless) {
+					sleep_ms(min((uint64_t)1000, future_time - current_time));
+					break;
+				}
+
 				//? Poll for input and process any input detected
 				else if (Input::poll(min((uint64_t)1000, future_time - current_time))) {
-					if (not Runner::active) Config::unlock();
+					Config::publish();
+					Runner::activity = true;
 
 					if (Menu::active) Menu::process(Input::get());
 					else Input::process(Input::get());
@@ -0,0 +1,783 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <array>
+#include <string_view>
+#include <charconv>
+#include <stdexcept>
+#include <algorithm>
+#ifdef __linux__
+	#include <cstdio>
+	#include <ctime>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <dirent.h>
+	#include <pwd.h>
+	#include <ifaddrs.h>
+	#include <net/if.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <sys/statvfs.h>
+	#include <sys/resource.h>
+	#include <cerrno>
+#endif
+
+#include "btop_backend.hpp"
+
+using std::array, std::pair, std::string_view, std::to_string, std::min, std::max;
+
+namespace Backend {
+
+	std::unique_ptr<Source> source;
+	std::unique_ptr<Recorder> recorder;
+
+	namespace {
+		constexpr uint64_t second_ticks = 10'000'000;
+
+		//* Split off the part of <line> before <delim> and advance <line> past it
+		string_view next_field(string_view& line, const char delim = '\t') {
+			const auto pos = line.find(delim);
+			const string_view field = line.substr(0, pos);
+			line.remove_prefix(pos == string_view::npos ? line.size() : pos + 1);
+			return field;
+		}
+
+		//* Parse space or tab separated unsigned integers from <line> into <values>, returns false if any is missing or invalid
+		template<typename... T>
+		bool parse_numbers(string_view line, T&... values) {
+			bool ok = true;
+			auto parse = [&](auto& value) {
+				while (not line.empty() and (line.front() == ' ' or line.front() == '\t')) line.remove_prefix(1);
+				const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), value);
+				if (ec != std::errc()) ok = false;
+				line.remove_prefix(ptr - line.data());
+			};
+			(parse(values), ...);
+			return ok;
+		}
+
+		//* Strings are written as tab separated fields, so tabs and line breaks are replaced with spaces
+		void write_field(std::ofstream& file, const string& str) {
+			file << '\t';
+			for (const char c : str) file << ((c == '\t' or c == '\n' or c == '\r') ? ' ' : c);
+		}
+	}
+
+	//* ---------------------------------------------- Synthetic --------------------------------------------------
+
+	Synthetic::Synthetic(const synthetic_config& config) : conf(config), rng_state(config.seed | 1) {
+		systime = 133'000'000ull * second_ticks;
+		cores.resize(max((size_t)1, conf.cores));
+		for (size_t i = 0; i < conf.disks; i++) {
+			disk_sample disk;
+			disk.mount = (i < 24 ? string(1, (char)('C' + i)) + ":\\" : "disk" + to_string(i));
+			disk.name = "Synthetic " + to_string(i);
+			disk.total = (512ull << 30) * (i + 1);
+			disk.free = disk.total / 2;
+			disk.has_io = true;
+			disks.push_back(disk);
+		}
+		for (size_t i = 0; i < conf.ifaces; i++) {
+			iface_sample iface;
+			iface.name = "Synthetic " + to_string(i);
+			iface.ipv4 = "10.0." + to_string(i % 256) + ".2";
+			iface.connected = (i == 0);
+			iface.has_io = true;
+			ifaces.push_back(iface);
+		}
+		table.reserve(conf.procs);
+		for (size_t i = 0; i < conf.procs; i++) table.push_back(new_proc());
+	}
+
+	uint64_t Synthetic::random() {
+		rng_state ^= rng_state >> 12;
+		rng_state ^= rng_state << 25;
+		rng_state ^= rng_state >> 27;
+		return rng_state * 0x2545F4914F6CDD1Dull;
+	}
+
+	auto Synthetic::new_proc() -> proc_state {
+		static const array<string_view, 8> names = { "explorer", "svchost", "chrome", "Resonite", "conhost", "RuntimeBroker", "dwm", "python" };
+		proc_state p;
+		p.pid = next_pid;
+		next_pid += 4;
+		p.ppid = (table.empty() ? 0 : table[random() % table.size()].pid);
+		p.threads = 1 + random() % 64;
+		p.mem = (1 + random() % 512) << 20;
+		p.created = systime;
+		p.cpu_t = 0;
+		//? Most processes are idle, a few use a large part of a core
+		p.load = (random() % 100 < 5 ? random() % 1000 : random() % 10);
+		const auto& name = names[random() % names.size()];
+		p.name = string(name) + (p.pid % 7 == 0 ? to_string(p.pid % 100) : "");
+		p.cmd = "C:\\Synthetic\\" + p.name + ".exe --instance " + to_string(p.pid);
+		p.user = (p.pid % 3 == 0 ? "SYSTEM" : "synthetic");
+		p.reported = false;
+		return p;
+	}
+
+	bool Synthetic::cpu(cpu_sample& out) {
+		for (auto& core : cores) {
+			const uint64_t busy = second_ticks * (random() % 100) / 100;
+			core.user += busy * 7 / 10;
+			core.kernel += busy * 2 / 10;
+			core.dpc += busy / 20;
+			core.interrupt += busy / 20;
+			core.idle += second_ticks - busy;
+		}
+		out.cores = cores;
+		return true;
+	}
+
+	bool Synthetic::mem(mem_sample& out) {
+		out.total = 32ull << 30;
+		out.used = out.total * (40 + random() % 40) / 100;
+		out.available = out.total - out.used;
+		out.cached = out.total / 10;
+		out.commit = out.used + out.used / 5;
+		out.commit_limit = out.total + out.total / 2;
+		out.page_total = 8ull << 30;
+		out.page_free = 6ull << 30;
+		out.timestamp = systime / (second_ticks / 1000);
+		for (auto& disk : disks) {
+			disk.read += (random() % 64) << 20;
+			disk.write += (random() % 32) << 20;
+			disk.io_time += (random() % 60) * 1'000'000;
+			disk.free = min(disk.total, disk.free + (random() % 3) * (1 << 20) - (1 << 20));
+		}
+		out.disks = disks;
+		return true;
+	}
+
+	bool Synthetic::net(net_sample& out) {
+		for (auto& iface : ifaces) {
+			iface.rx += random() % (10 << 20);
+			iface.tx += random() % (2 << 20);
+		}
+		out.ifaces = ifaces;
+		return true;
+	}
+
+	bool Synthetic::procs(proc_list& out) {
+		systime += second_ticks;
+
+		//? Replace a part of the processes with new ones
+		const size_t churn = (size_t)(conf.churn * table.size());
+		for (size_t i = 0; i < churn and not table.empty(); i++) {
+			table[random() % table.size()] = new_proc();
+		}
+
+		out.procs.resize(table.size());
+		uint64_t cpu_delta = (uint64_t)cores.size() * second_ticks / 100;
+		for (size_t i = 0; auto& p : table) {
+			const uint64_t used = p.load * (second_ticks / 1000) * (80 + random() % 40) / 100;
+			p.cpu_t += used;
+			cpu_delta += used;
+			auto& s = out.procs[i++];
+			s.pid = p.pid;
+			s.ppid = p.ppid;
+			s.threads = p.threads;
+			s.mem = p.mem;
+			s.created = p.created;
+			s.cpu_t = p.cpu_t;
+			s.name.clear();
+			s.cmd.clear();
+			s.user.clear();
+			if (not p.reported) {
+				s.name = p.name;
+				s.cmd = p.cmd;
+				s.user = p.user;
+				p.reported = true;
+			}
+		}
+		cpu_total += cpu_delta;
+		out.cpu_total = cpu_total;
+		out.systime = systime;
+		return true;
+	}
+
+	//* ------------------------------------------------ Replay ---------------------------------------------------
+
+	Replay::Replay(const string& path) {
+		std::ifstream file(path);
+		if (not file.good()) throw std::runtime_error("Backend::Replay() -> Could not open " + path);
+
+		string buffer;
+		while (std::getline(file, buffer)) {
+			string_view line = buffer;
+			const auto kind = next_field(line);
+			bool ok = true;
+			if (kind == "cpu") {
+				auto& sample = cpu_frames.emplace_back();
+				while (not line.empty()) {
+					auto& core = sample.cores.emplace_back();
+					ok = ok and parse_numbers(next_field(line), core.kernel, core.user, core.dpc, core.interrupt, core.idle);
+				}
+			}
+			else if (kind == "mem") {
+				auto& s = mem_frames.emplace_back();
+				ok = parse_numbers(line, s.total, s.available, s.used, s.cached, s.commit, s.commit_limit, s.page_total, s.page_free, s.timestamp);
+			}
+			else if (kind == "disk" and not mem_frames.empty()) {
+				auto& disk = mem_frames.back().disks.emplace_back();
+				disk.mount = next_field(line);
+				disk.name = next_field(line);
+				uint64_t has_io = 0;
+				ok = parse_numbers(line, disk.total, disk.free, has_io, disk.read, disk.write, disk.io_time);
+				disk.has_io = (has_io != 0);
+			}
+			else if (kind == "net") {
+				net_frames.emplace_back();
+			}
+			else if (kind == "iface" and not net_frames.empty()) {
+				auto& iface = net_frames.back().ifaces.emplace_back();
+				iface.name = next_field(line);
+				iface.ipv4 = next_field(line);
+				iface.ipv6 = next_field(line);
+				uint64_t connected = 0, has_io = 0;
+				ok = parse_numbers(line, connected, has_io, iface.rx, iface.tx);
+				iface.connected = (connected != 0);
+				iface.has_io = (has_io != 0);
+			}
+			else if (kind == "procs") {
+				auto& s = proc_frames.emplace_back();
+				ok = parse_numbers(line, s.cpu_total, s.systime);
+			}
+			else if (kind == "proc" and not proc_frames.empty()) {
+				auto& p = proc_frames.back().procs.emplace_back();
+				ok = parse_numbers(next_field(line), p.pid, p.ppid, p.threads, p.mem, p.created, p.cpu_t);
+				p.name = next_field(line);
+				p.cmd = next_field(line);
+				p.user = next_field(line);
+
+				//? Keep the strings from the first time a process is seen, later frames only carry them for new processes
+				if (not p.name.empty() or not p.cmd.empty() or not p.user.empty()) {
+					auto& known = meta[p.pid];
+					if (std::ranges::find(known, p.created, &proc_meta::created) == known.end())
+						known.push_back({p.created, p.name, p.cmd, p.user});
+				}
+			}
+			if (not ok) throw std::runtime_error("Backend::Replay() -> Invalid line in " + path + ": " + buffer);
+		}
+		if (cpu_frames.empty() and mem_frames.empty() and net_frames.empty() and proc_frames.empty())
+			throw std::runtime_error("Backend::Replay() -> No samples found in " + path);
+	}
+
+	bool Replay::cpu(cpu_sample& out) {
+		if (cpu_frames.empty()) return false;
+		out = cpu_frames[cpu_pos];
+		cpu_pos = (cpu_pos + 1) % cpu_frames.size();
+		return true;
+	}
+
+	bool Replay::mem(mem_sample& out) {
+		if (mem_frames.empty()) return false;
+		out = mem_frames[mem_pos];
+		mem_pos = (mem_pos + 1) % mem_frames.size();
+		return true;
+	}
+
+	bool Replay::net(net_sample& out) {
+		if (net_frames.empty()) return false;
+		out = net_frames[net_pos];
+		net_pos = (net_pos + 1) % net_frames.size();
+		return true;
+	}
+
+	bool Replay::procs(proc_list& out) {
+		if (proc_frames.empty()) return false;
+		out = proc_frames[proc_pos];
+		proc_pos = (proc_pos + 1) % proc_frames.size();
+
+		//? A process missing from the last frame needs its strings again, this happens when looping back to the first frame
+		for (auto& p : out.procs) {
+			if (not p.name.empty()) continue;
+			if (auto last = last_served.find(p.pid); last != last_served.end() and last->second == p.created) continue;
+			if (auto known = meta.find(p.pid); known != meta.end()) {
+				if (auto m = std::ranges::find(known->second, p.created, &proc_meta::created); m != known->second.end()) {
+					p.name = m->name;
+					p.cmd = m->cmd;
+					p.user = m->user;
+				}
+			}
+		}
+		last_served.clear();
+		for (const auto& p : out.procs) last_served[p.pid] = p.created;
+		return true;
+	}
+
+	//* ------------------------------------------------- Linux ---------------------------------------------------
+
+	#ifdef __linux__
+	namespace {
+		//? Upper bound for stat files kept open, the rest of the descriptor limit is left to read_at(), logging and sockets
+		constexpr size_t max_kept_stats = 4096;
+		constexpr size_t min_free_fds = 64;
+
+		//* Skip <count> space separated fields of <line>
+		void skip_fields(string_view& line, size_t count) {
+			while (count-- > 0 and not line.empty()) {
+				while (not line.empty() and line.front() == ' ') line.remove_prefix(1);
+				const auto pos = line.find(' ');
+				line.remove_prefix(pos == string_view::npos ? line.size() : pos);
+			}
+		}
+
+		//* Parse the next space separated unsigned integer of <line> and advance past it, 0 if invalid
+		uint64_t next_number(string_view& line) {
+			while (not line.empty() and line.front() == ' ') line.remove_prefix(1);
+			uint64_t value = 0;
+			const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), value);
+			if (ec != std::errc()) {
+				skip_fields(line, 1);
+				return 0;
+			}
+			line.remove_prefix(ptr - line.data());
+			return value;
+		}
+
+		//* Value of the "<key>: <number>" line in <text>, 0 if missing
+		uint64_t find_value(string_view text, string_view key) {
+			for (size_t pos = 0; (pos = text.find(key, pos)) != string_view::npos; pos += key.size()) {
+				if ((pos == 0 or text[pos - 1] == '\n') and text.substr(pos + key.size()).starts_with(':')) {
+					uint64_t value = 0;
+					parse_numbers(text.substr(pos + key.size() + 1), value);
+					return value;
+				}
+			}
+			return 0;
+		}
+
+		//* Paths in /proc/mounts have spaces and tabs escaped as octal
+		string unescape_mount(string_view path) {
+			string out;
+			out.reserve(path.size());
+			for (size_t i = 0; i < path.size(); i++) {
+				if (path[i] == '\\' and i + 3 < path.size()) {
+					int value = 0;
+					if (const auto [ptr, ec] = std::from_chars(path.data() + i + 1, path.data() + i + 4, value, 8); ec == std::errc() and ptr == path.data() + i + 4) {
+						out.push_back((char)value);
+						i += 3;
+						continue;
+					}
+				}
+				out.push_back(path[i]);
+			}
+			return out;
+		}
+
+		uint64_t clock_100ns(clockid_t clock) {
+			struct timespec ts;
+			clock_gettime(clock, &ts);
+			return (uint64_t)ts.tv_sec * second_ticks + (uint64_t)ts.tv_nsec / 100;
+		}
+	}
+
+	Linux::Linux() : buffer(16384) {
+		proc_fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (proc_fd < 0) throw std::runtime_error("Backend::Linux() -> Could not open /proc");
+		for (auto [fd, path] : { pair{&stat_fd, "stat"}, {&meminfo_fd, "meminfo"}, {&mounts_fd, "self/mounts"}, {&diskstats_fd, "diskstats"}, {&netdev_fd, "net/dev"} }) {
+			*fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+		}
+		if (stat_fd < 0 or meminfo_fd < 0) throw std::runtime_error("Backend::Linux() -> Could not open /proc/stat or /proc/meminfo");
+		tick = second_ticks / max(1l, sysconf(_SC_CLK_TCK));
+		page_size = (uint64_t)max(1l, sysconf(_SC_PAGESIZE));
+
+		//? Keep at most 3/4 of the soft descriptor limit and at least <min_free_fds> descriptors free
+		if (struct rlimit limit; getrlimit(RLIMIT_NOFILE, &limit) == 0 and limit.rlim_cur != RLIM_INFINITY) {
+			const size_t soft = limit.rlim_cur;
+			const size_t reserve = max(min_free_fds, soft / 4);
+			max_open_stats = (soft > reserve ? min(max_kept_stats, soft - reserve) : 0);
+		}
+		else max_open_stats = max_kept_stats;
+	}
+
+	Linux::~Linux() {
+		for (auto& [pid, p] : table) if (p.stat_fd >= 0) close(p.stat_fd);
+		for (const int fd : { stat_fd, meminfo_fd, mounts_fd, diskstats_fd, netdev_fd, proc_fd }) if (fd >= 0) close(fd);
+	}
+
+	//* Read the whole file behind <fd> into the shared buffer, growing it if needed, empty if the read failed
+	string_view Linux::read(int fd) {
+		if (fd < 0) return {};
+		while (true) {
+			const ssize_t n = pread(fd, buffer.data(), buffer.size(), 0);
+			if (n < 0) return {};
+			if ((size_t)n < buffer.size()) return { buffer.data(), (size_t)n };
+			buffer.resize(buffer.size() * 2);
+		}
+	}
+
+	//* Read a file relative to /proc without keeping it open
+	string_view Linux::read_at(const char* path) {
+		const int fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return {};
+		const auto text = read(fd);
+		close(fd);
+		return text;
+	}
+
+	//* Lower the number of stat files kept open to <keep> and close the ones above it, used when running out of descriptors
+	void Linux::release_stats(const size_t keep) {
+		max_open_stats = keep;
+		for (auto& [pid, p] : table) {
+			if (open_stats <= keep) break;
+			if (p.stat_fd >= 0) {
+				close(p.stat_fd);
+				p.stat_fd = -1;
+				open_stats--;
+			}
+		}
+	}
+
+	bool Linux::read_cpu(cpu_sample& out, uint64_t& total) {
+		string_view text = read(stat_fd);
+		if (text.empty()) return false;
+		total = 0;
+		while (not text.empty()) {
+			string_view line = next_field(text, '\n');
+			if (not line.starts_with("cpu")) break;
+			line.remove_prefix(3);
+			const bool all = line.starts_with(' ');
+			size_t index = 0;
+			if (not all) {
+				const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), index);
+				if (ec != std::errc()) continue;
+				line.remove_prefix(ptr - line.data());
+			}
+			uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0, softirq = 0, steal = 0;
+			parse_numbers(line, user, nice, system, idle, iowait, irq, softirq, steal);
+			if (all) {
+				total = (user + nice + system + idle + iowait + irq + softirq + steal) * tick;
+				continue;
+			}
+			//? Offline cores keep their last values so the core count doesn't change
+			if (index >= cores.size()) cores.resize(index + 1);
+			cores[index] = {
+				.kernel = (system + steal) * tick,
+				.user = (user + nice) * tick,
+				.dpc = softirq * tick,
+				.interrupt = irq * tick,
+				.idle = (idle + iowait) * tick
+			};
+		}
+		out.cores = cores;
+		return not cores.empty();
+	}
+
+	bool Linux::cpu(cpu_sample& out) {
+		uint64_t total;
+		return read_cpu(out, total);
+	}
+
+	bool Linux::mem(mem_sample& out) {
+		const string_view text = read(meminfo_fd);
+		if (text.empty()) return false;
+		out.total = find_value(text, "MemTotal") << 10;
+		out.available = find_value(text, "MemAvailable") << 10;
+		out.used = out.total - min(out.total, out.available);
+		out.cached = find_value(text, "Cached") << 10;
+		out.commit = find_value(text, "Committed_AS") << 10;
+		out.commit_limit = max((uint64_t)1, find_value(text, "CommitLimit")) << 10;
+		out.page_total = find_value(text, "SwapTotal") << 10;
+		out.page_free = find_value(text, "SwapFree") << 10;
+		out.timestamp = clock_100ns(CLOCK_MONOTONIC) / (second_ticks / 1000);
+
+		//? Block devices from the mount table, usage from statvfs() and io counters from /proc/diskstats
+		out.disks.clear();
+		for (string_view mounts = read(mounts_fd); not mounts.empty();) {
+			string_view line = next_field(mounts, '\n');
+			const auto device = next_field(line, ' ');
+			const auto mount = next_field(line, ' ');
+			if (not device.starts_with("/dev/")) continue;
+			const auto name = device.substr(device.rfind('/') + 1);
+			if (std::ranges::any_of(out.disks, [&](const auto& d) { return d.name == name; })) continue;
+			auto& disk = out.disks.emplace_back();
+			disk.mount = unescape_mount(mount);
+			disk.name = name;
+			if (struct statvfs vfs; statvfs(disk.mount.c_str(), &vfs) == 0) {
+				disk.total = (uint64_t)vfs.f_blocks * vfs.f_frsize;
+				disk.free = (uint64_t)vfs.f_bavail * vfs.f_frsize;
+			}
+		}
+		for (string_view stats = read(diskstats_fd); not stats.empty();) {
+			string_view line = next_field(stats, '\n');
+			skip_fields(line, 2);
+			while (not line.empty() and line.front() == ' ') line.remove_prefix(1);
+			const auto name = next_field(line, ' ');
+			auto disk = std::ranges::find(out.disks, name, &disk_sample::name);
+			if (disk == out.disks.end()) continue;
+			uint64_t reads, reads_merged, sectors_read, read_ms, writes, writes_merged, sectors_written, write_ms, in_progress, io_ms;
+			if (not parse_numbers(line, reads, reads_merged, sectors_read, read_ms, writes, writes_merged, sectors_written, write_ms, in_progress, io_ms)) continue;
+			disk->has_io = true;
+			disk->read = sectors_read * 512;
+			disk->write = sectors_written * 512;
+			disk->io_time = io_ms * (second_ticks / 1000);
+		}
+		return true;
+	}
+
+	bool Linux::net(net_sample& out) {
+		string_view text = read(netdev_fd);
+		if (text.empty()) return false;
+		out.ifaces.clear();
+
+		//? The first two lines are headers
+		next_field(text, '\n');
+		next_field(text, '\n');
+		while (not text.empty()) {
+			string_view line = next_field(text, '\n');
+			auto name = next_field(line, ':');
+			while (not name.empty() and name.front() == ' ') name.remove_prefix(1);
+			if (name.empty() or name == "lo") continue;
+			auto& iface = out.ifaces.emplace_back();
+			iface.name = name;
+			uint64_t rx_packets, rx_errors, rx_drop, rx_fifo, rx_frame, rx_compressed, rx_multicast;
+			iface.has_io = parse_numbers(line, iface.rx, rx_packets, rx_errors, rx_drop, rx_fifo, rx_frame, rx_compressed, rx_multicast, iface.tx);
+		}
+
+		//? Addresses and link state
+		if (struct ifaddrs* addrs; getifaddrs(&addrs) == 0) {
+			char ip[INET6_ADDRSTRLEN];
+			for (auto* a = addrs; a != nullptr; a = a->ifa_next) {
+				auto iface = std::ranges::find(out.ifaces, string_view(a->ifa_name), &iface_sample::name);
+				if (iface == out.ifaces.end()) continue;
+				iface->connected = iface->connected or (a->ifa_flags & IFF_RUNNING);
+				if (a->ifa_addr == nullptr) continue;
+				const auto family = a->ifa_addr->sa_family;
+				if (family == AF_INET and iface->ipv4.empty()
+				and inet_ntop(AF_INET, &reinterpret_cast<sockaddr_in*>(a->ifa_addr)->sin_addr, ip, sizeof(ip)) != nullptr)
+					iface->ipv4 = ip;
+				else if (family == AF_INET6 and iface->ipv6.empty()
+				and inet_ntop(AF_INET6, &reinterpret_cast<sockaddr_in6*>(a->ifa_addr)->sin6_addr, ip, sizeof(ip)) != nullptr)
+					iface->ipv6 = ip;
+			}
+			freeifaddrs(addrs);
+		}
+		return true;
+	}
+
+	//* Name, command line and user of a new process, only read once for each pid and start time
+	void Linux::read_static(proc_sample& s) {
+		char path[64];
+		snprintf(path, sizeof(path), "%zu/cmdline", s.pid);
+		const auto cmdline = read_at(path);
+		s.cmd.assign(cmdline.data(), cmdline.size());
+		while (not s.cmd.empty() and s.cmd.back() == '\0') s.cmd.pop_back();
+		std::ranges::replace(s.cmd, '\0', ' ');
+
+		snprintf(path, sizeof(path), "%zu/status", s.pid);
+		uint32_t uid = 0;
+		if (const auto status = read_at(path); not status.empty()) {
+			if (const auto pos = status.find("\nUid:"); pos != string_view::npos) parse_numbers(status.substr(pos + 5), uid);
+		}
+		auto user = users.find(uid);
+		if (user == users.end()) {
+			struct passwd pwd, *result = nullptr;
+			array<char, 1024> pwd_buffer;
+			string name = (getpwuid_r(uid, &pwd, pwd_buffer.data(), pwd_buffer.size(), &result) == 0 and result != nullptr ? pwd.pw_name : to_string(uid));
+			user = users.emplace(uid, std::move(name)).first;
+		}
+		s.user = user->second;
+	}
+
+	bool Linux::procs(proc_list& out) {
+		cpu_sample cpu_times;
+		if (not read_cpu(cpu_times, out.cpu_total)) return false;
+		out.systime = clock_100ns(CLOCK_BOOTTIME);
+		out.procs.clear();
+		generation++;
+
+		DIR* dir = opendir("/proc");
+		if (dir == nullptr) return false;
+		char path[64];
+		while (const auto* entry = readdir(dir)) {
+			size_t pid = 0;
+			const string_view dname = entry->d_name;
+			if (const auto [ptr, ec] = std::from_chars(dname.data(), dname.data() + dname.size(), pid); ec != std::errc() or ptr != dname.data() + dname.size()) continue;
+
+			//? Keep stat open while the process lives, a descriptor for a dead process fails to read and is reopened
+			auto& p = table[pid];
+			string_view text;
+			if (p.stat_fd >= 0) {
+				text = read(p.stat_fd);
+				if (text.empty()) {
+					close(p.stat_fd);
+					p.stat_fd = -1;
+					open_stats--;
+				}
+			}
+			if (p.stat_fd < 0) {
+				snprintf(path, sizeof(path), "%zu/stat", pid);
+				if (open_stats < max_open_stats) {
+					p.stat_fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+					if (p.stat_fd >= 0) open_stats++;
+					//? Out of descriptors anyway, something else is holding them, give back half of the kept ones so read_at() can work
+					else if (errno == EMFILE or errno == ENFILE) release_stats(open_stats / 2);
+				}
+				text = (p.stat_fd >= 0 ? read(p.stat_fd) : read_at(path));
+			}
+
+			//? Format is "pid (comm) state ppid ...", comm can contain spaces and parentheses
+			const auto name_start = text.find('('), name_end = text.rfind(')');
+			if (name_start == string_view::npos or name_end == string_view::npos or name_end < name_start) {
+				if (p.stat_fd >= 0) {
+					close(p.stat_fd);
+					open_stats--;
+				}
+				table.erase(pid);
+				continue;
+			}
+			string_view fields = text.substr(name_end + 2);
+			auto& s = out.procs.emplace_back();
+			s.pid = pid;
+			skip_fields(fields, 1);
+			s.ppid = next_number(fields);
+			skip_fields(fields, 9);
+			const uint64_t utime = next_number(fields), stime = next_number(fields);
+			s.cpu_t = (utime + stime) * tick;
+			skip_fields(fields, 4);
+			s.threads = next_number(fields);
+			skip_fields(fields, 1);
+			s.created = next_number(fields) * tick;
+			skip_fields(fields, 1);
+			s.mem = next_number(fields) * page_size;
+
+			if (p.generation == 0 or p.created != s.created) {
+				s.name = text.substr(name_start + 1, name_end - name_start - 1);
+				read_static(s);
+			}
+			p.created = s.created;
+			p.generation = generation;
+		}
+		closedir(dir);
+
+		//? Close descriptors of processes that are gone
+		for (auto it = table.begin(); it != table.end();) {
+			if (it->second.generation != generation) {
+				if (it->second.stat_fd >= 0) {
+					close(it->second.stat_fd);
+					open_stats--;
+				}
+				it = table.erase(it);
+			}
+			else it++;
+		}
+		return true;
+	}
+	#endif
+
+	//* ----------------------------------------------- Recorder --------------------------------------------------
+
+	Recorder::Recorder(const string& path) : file(path, std::ios::out | std::ios::trunc) {}
+
+	void Recorder::write(const cpu_sample& sample) {
+		file << "cpu";
+		for (const auto& c : sample.cores)
+			file << '\t' << c.kernel << ' ' << c.user << ' ' << c.dpc << ' ' << c.interrupt << ' ' << c.idle;
+		file << '\n';
+	}
+
+	void Recorder::write(const mem_sample& s) {
+		file << "mem\t" << s.total << ' ' << s.available << ' ' << s.used << ' ' << s.cached << ' ' << s.commit << ' '
+			 << s.commit_limit << ' ' << s.page_total << ' ' << s.page_free << ' ' << s.timestamp << '\n';
+		for (const auto& disk : s.disks) {
+			file << "disk";
+			write_field(file, disk.mount);
+			write_field(file, disk.name);
+			file << '\t' << disk.total << ' ' << disk.free << ' ' << (int)disk.has_io << ' ' << disk.read << ' ' << disk.write << ' ' << disk.io_time << '\n';
+		}
+	}
+
+	void Recorder::write(const net_sample& sample) {
+		file << "net\n";
+		for (const auto& iface : sample.ifaces) {
+			file << "iface";
+			write_field(file, iface.name);
+			write_field(file, iface.ipv4);
+			write_field(file, iface.ipv6);
+			file << '\t' << (int)iface.connected << ' ' << (int)iface.has_io << ' ' << iface.rx << ' ' << iface.tx << '\n';
+		}
+	}
+
+	void Recorder::write(const proc_list& sample) {
+		file << "procs\t" << sample.cpu_total << ' ' << sample.systime << '\n';
+		current_procs.clear();
+		for (const auto& p : sample.procs) {
+			file << "proc\t" << p.pid << ' ' << p.ppid << ' ' << p.threads << ' ' << p.mem << ' ' << p.created << ' ' << p.cpu_t;
+			//? Strings are only written the first time a process is seen
+			if (auto last = last_procs.find(p.pid); last == last_procs.end() or last->second != p.created) {
+				write_field(file, p.name);
+				write_field(file, p.cmd);
+				write_field(file, p.user);
+			}
+			file << '\n';
+			current_procs[p.pid] = p.created;
+		}
+		last_procs.swap(current_procs);
+		file.flush();
+	}
+
+	//* ------------------------------------------------- Setup ---------------------------------------------------
+
+	void init(const string& spec) {
+		const string_view kind = string_view(spec).substr(0, spec.find(':'));
+		const string_view args = (kind.size() < spec.size() ? string_view(spec).substr(kind.size() + 1) : string_view{});
+
+		if (kind == "synthetic") {
+			synthetic_config config;
+			for (string_view rest = args; not rest.empty();) {
+				string_view option = next_field(rest, ',');
+				const string_view key = next_field(option, '=');
+				bool ok = true;
+				if (key == "cores") ok = parse_numbers(option, config.cores);
+				else if (key == "procs") ok = parse_numbers(option, config.procs);
+				else if (key == "disks") ok = parse_numbers(option, config.disks);
+				else if (key == "ifaces") ok = parse_numbers(option, config.ifaces);
+				else if (key == "seed") ok = parse_numbers(option, config.seed);
+				else if (key == "churn") {
+					try { config.churn = std::clamp(std::stod(string(option)), 0.0, 1.0); }
+					catch (const std::exception&) { ok = false; }
+				}
+				else ok = false;
+				if (not ok) throw std::runtime_error("Backend::init() -> Invalid synthetic option: " + string(key));
+			}
+			if (config.cores < 1 or config.cores > 4096) throw std::runtime_error("Backend::init() -> Synthetic core count must be between 1 and 4096");
+			source = std::make_unique<Synthetic>(config);
+		}
+		else if (kind == "replay" and not args.empty()) {
+			source = std::make_unique<Replay>(string(args));
+		}
+	#ifdef __linux__
+		else if (kind == "linux") {
+			source = std::make_unique<Linux>();
+		}
+	#endif
+		else if (kind != "native") {
+			throw std::runtime_error("Backend::init() -> Unknown backend: " + spec);
+		}
+	}
+
+	void record(const string& path) {
+		recorder = std::make_unique<Recorder>(path);
+		if (not recorder->good()) {
+			recorder.reset();
+			throw std::runtime_error("Backend::record() -> Could not open " + path + " for writing");
+		}
+	}
+}
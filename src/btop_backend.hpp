@@ -0,0 +1,204 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <cstdint>
+#include <robin_hood.h>
+
+using std::string, std::vector, robin_hood::unordered_flat_map;
+
+//* Raw counters handed from a collector backend to the portable parts of Cpu/Mem/Net/Proc::collect()
+//* The native Win32 collectors are used when no backend is set, they produce the same samples for Cpu, Mem and Net
+namespace Backend {
+
+	//* Cumulative cpu times for one core, any unit as long as it's the same for all fields, kernel doesn't include idle
+	struct core_times {
+		uint64_t kernel = 0, user = 0, dpc = 0, interrupt = 0, idle = 0;
+	};
+
+	struct cpu_sample {
+		vector<core_times> cores;
+	};
+
+	//* Disk usage in bytes and cumulative io counters, io_time is busy time in 100ns ticks
+	struct disk_sample {
+		string mount, name;
+		uint64_t total = 0, free = 0;
+		bool has_io = false;
+		uint64_t read = 0, write = 0, io_time = 0;
+	};
+
+	//* Memory stats in bytes, timestamp in milliseconds from any fixed point
+	struct mem_sample {
+		uint64_t total = 0, available = 0, used = 0, cached = 0, commit = 0, commit_limit = 0, page_total = 0, page_free = 0;
+		uint64_t timestamp = 0;
+		vector<disk_sample> disks;
+	};
+
+	//* Cumulative received and transmitted bytes for one interface
+	struct iface_sample {
+		string name, ipv4, ipv6;
+		bool connected = false, has_io = false;
+		uint64_t rx = 0, tx = 0;
+	};
+
+	struct net_sample {
+		vector<iface_sample> ifaces;
+	};
+
+	//* One process, times in 100ns ticks with <created> and <systime> as FILETIME style timestamps
+	//* name, cmd and user can be left empty if the process was in the previous sample with the same creation time
+	struct proc_sample {
+		size_t pid = 0, ppid = 0, threads = 0;
+		uint64_t mem = 0, created = 0, cpu_t = 0;
+		string name, cmd, user;
+	};
+
+	//* All processes at one point in time, <cpu_total> is the summed cpu time of all cores in the same unit as proc_sample::cpu_t
+	struct proc_list {
+		uint64_t cpu_total = 0, systime = 0;
+		vector<proc_sample> procs;
+	};
+
+	//* Interface for a source of samples, every call returns the next sample, false if nothing could be read
+	class Source {
+	public:
+		virtual ~Source() = default;
+		virtual string name() const = 0;
+		virtual bool cpu(cpu_sample& out) = 0;
+		virtual bool mem(mem_sample& out) = 0;
+		virtual bool net(net_sample& out) = 0;
+		virtual bool procs(proc_list& out) = 0;
+	};
+
+	//* Settings for the synthetic backend, churn is the fraction of processes replaced each sample
+	struct synthetic_config {
+		size_t cores = 8, procs = 300, disks = 2, ifaces = 2;
+		double churn = 0.01;
+		uint64_t seed = 1;
+	};
+
+	//* Generates a deterministic but changing system of any size, for profiling the portable code without real hardware
+	class Synthetic final : public Source {
+		struct proc_state {
+			size_t pid, ppid, threads;
+			uint64_t mem, created, cpu_t, load;
+			string name, cmd, user;
+			bool reported;
+		};
+		synthetic_config conf;
+		uint64_t rng_state, systime = 0, cpu_total = 0;
+		size_t next_pid = 4;
+		vector<core_times> cores;
+		vector<disk_sample> disks;
+		vector<iface_sample> ifaces;
+		vector<proc_state> table;
+		uint64_t random();
+		proc_state new_proc();
+	public:
+		Synthetic(const synthetic_config& config);
+		string name() const override { return "synthetic"; }
+		bool cpu(cpu_sample& out) override;
+		bool mem(mem_sample& out) override;
+		bool net(net_sample& out) override;
+		bool procs(proc_list& out) override;
+	};
+
+	//* Plays back samples written by Recorder, each kind of sample loops on its own when reaching the end of the file
+	class Replay final : public Source {
+		struct proc_meta {
+			uint64_t created;
+			string name, cmd, user;
+		};
+		vector<cpu_sample> cpu_frames;
+		vector<mem_sample> mem_frames;
+		vector<net_sample> net_frames;
+		vector<proc_list> proc_frames;
+		size_t cpu_pos = 0, mem_pos = 0, net_pos = 0, proc_pos = 0;
+		unordered_flat_map<size_t, vector<proc_meta>> meta;
+		unordered_flat_map<size_t, uint64_t> last_served;
+	public:
+		Replay(const string& path);
+		string name() const override { return "replay"; }
+		bool cpu(cpu_sample& out) override;
+		bool mem(mem_sample& out) override;
+		bool net(net_sample& out) override;
+		bool procs(proc_list& out) override;
+	};
+
+	#ifdef __linux__
+	//* Reads /proc, system wide files are kept open and re-read with pread(), cmdline and status are read once per process
+	class Linux final : public Source {
+		struct proc_state {
+			int stat_fd = -1;
+			uint64_t created = 0, generation = 0;
+		};
+		int proc_fd = -1, stat_fd = -1, meminfo_fd = -1, mounts_fd = -1, diskstats_fd = -1, netdev_fd = -1;
+		uint64_t tick = 0, page_size = 0, generation = 0;
+		size_t open_stats = 0, max_open_stats = 0;
+		vector<char> buffer;
+		vector<core_times> cores;
+		unordered_flat_map<size_t, proc_state> table;
+		unordered_flat_map<uint32_t, string> users;
+		std::string_view read(int fd);
+		std::string_view read_at(const char* path);
+		void release_stats(const size_t keep);
+		bool read_cpu(cpu_sample& out, uint64_t& total);
+		void read_static(proc_sample& s);
+	public:
+		Linux();
+		~Linux();
+		string name() const override { return "linux"; }
+		bool cpu(cpu_sample& out) override;
+		bool mem(mem_sample& out) override;
+		bool net(net_sample& out) override;
+		bool procs(proc_list& out) override;
+	};
+	#endif
+
+	//* Appends samples to a file readable by Replay, one tab separated record per line
+	class Recorder {
+		std::ofstream file;
+		unordered_flat_map<size_t, uint64_t> last_procs, current_procs;
+	public:
+		Recorder(const string& path);
+		bool good() const { return file.good(); }
+		void write(const cpu_sample& sample);
+		void write(const mem_sample& sample);
+		void write(const net_sample& sample);
+		void write(const proc_list& sample);
+	};
+
+	//? Active backend, the native collectors are used if not set
+	extern std::unique_ptr<Source> source;
+
+	//? Writes every sample to a file if set
+	extern std::unique_ptr<Recorder> recorder;
+
+	//* Set up backend from <spec>, "synthetic[:cores=N,procs=N,churn=F,disks=N,ifaces=N,seed=N]", "replay:<file>" or "linux", throws on invalid spec
+	void init(const string& spec);
+
+	//* Start writing samples to <path>, throws if the file can't be opened
+	void record(const string& path);
+}
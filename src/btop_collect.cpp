@@ -62,6 +62,7 @@ tab-size = 4
 #include <btop_config.hpp>
 #include <btop_tools.hpp>
 #include <btop_draw.hpp>
+#include <btop_backend.hpp>
 
 #ifdef LHM_Enabled
 	#pragma comment(lib, "external\\CPPdll.lib")
@@ -179,8 +180,6 @@ namespace Mem {
 }
 
 namespace Cpu {
-	vector<long long> core_old_totals;
-	vector<long long> core_old_idles;
 	vector<string> available_fields;
 	vector<string> available_sensors = { "Auto" };
 	cpu_info current_cpu;
@@ -909,7 +908,7 @@ namespace Proc {
 namespace Shared {
 
 	fs::path procPath, passwd_path;
-	long pageSize, clkTck, coreCount;
+	long pageSize, clkTck;
 
 	void init_status(const string status) {
 	#ifdef LHM_Enabled
@@ -917,7 +916,7 @@ namespace Shared {
 	#else
 		static bool enabled = false;
 	#endif
-		if (not enabled) return;
+		if (not enabled or Global::arg_headless) return;
 		static int current = 0;
 		static const int x = Term::width / 2 - 15;
 		static const int y = Term::height / 2 - 10;
@@ -959,6 +958,12 @@ namespace Shared {
 		GetSystemInfo(&sysinfo);
 
 		coreCount = sysinfo.dwNumberOfProcessors;
+
+		//? Core count comes from the first sample when using a collector backend
+		if (Backend::source) {
+			init_status("Starting " + Backend::source->name() + " backend");
+			if (Backend::cpu_sample sample; Backend::source->cpu(sample)) coreCount = sample.cores.size();
+		}
 		if (coreCount < 1) {
 			throw std::runtime_error("Could not determine number of cores!");
 		}
@@ -974,7 +979,7 @@ namespace Shared {
 	#ifdef LHM_Enabled
 		init_status("Libre Hardware Monitor Init");
 		//? Start up background thread for Libre Hardware Monitor
-		if (Config::bools.at("enable_ohmr")) {
+		if (Config::getB("enable_ohmr") and not Backend::source) {
 			Cpu::OHMR_init();
 			if (Cpu::has_OHMR) std::thread(Cpu::OHMR_collect).detach();
 		}
@@ -990,11 +995,9 @@ namespace Shared {
 		Cpu::current_cpu.core_percent.insert(Cpu::current_cpu.core_percent.begin(), Shared::coreCount, {});
 		Cpu::current_cpu.temp.insert(Cpu::current_cpu.temp.begin(), Shared::coreCount + 1, {});
 		Cpu::current_cpu.temp_max = 100;
-		Cpu::core_old_totals.insert(Cpu::core_old_totals.begin(), Shared::coreCount, 0);
-		Cpu::core_old_idles.insert(Cpu::core_old_idles.begin(), Shared::coreCount, 0);
 		Cpu::collect();
-		for (auto& [field, vec] : Cpu::current_cpu.cpu_percent) {
-			if (not vec.empty()) Cpu::available_fields.push_back(field);
+		for (int field = 0; field < Cpu::CFcount; field++) {
+			if (not Cpu::current_cpu.cpu_percent[field].empty()) Cpu::available_fields.push_back(Cpu::field_names[field]);
 		}
 		Cpu::cpuName = Cpu::get_cpuName();
 
@@ -1033,19 +1036,6 @@ namespace Cpu {
 	tuple<int, long, string> current_bat;
 	string current_gpu = "";
 
-	const array<string, 6> time_names = { "kernel", "user", "dpc", "interrupt", "idle" };
-
-	unordered_flat_map<string, long long> cpu_old = {
-			{"total", 0},
-			{"kernel", 0},
-			{"user", 0},
-			{"dpc", 0},
-			{"interrupt", 0},
-			{"idle", 0},
-			{"totals", 0},
-			{"idles", 0}
-		};
-
 	typedef struct _PROCESSOR_POWER_INFORMATION {
 		ULONG Number;
 		ULONG MaxMhz;
@@ -1183,7 +1173,7 @@ namespace Cpu {
 	}
 
 	auto collect(const bool no_update) -> cpu_info& {
-		if (Runner::stopping or (no_update and not current_cpu.cpu_percent.at("total").empty())) return current_cpu;
+		if (Runner::stopping or (no_update and not current_cpu.cpu_percent[CFtotal].empty())) return current_cpu;
 		auto& cpu = current_cpu;
 
 		if (has_OHMR) {
@@ -1201,12 +1191,12 @@ namespace Cpu {
 
 			if (got_sensors) {
 				current_cpu.temp.at(0).push_back(OHMRrawStats.CPU.at(0));
-				if (current_cpu.temp.at(0).size() > 20) current_cpu.temp.at(0).pop_front();
+				current_cpu.temp.at(0).trim(20);
 
 				for (const auto& [core, temp] : core_mapping) {
 					if (cmp_less(core + 1, current_cpu.temp.size()) and cmp_less(temp, OHMRrawStats.CPU.size() - 1)) {
 						current_cpu.temp.at(core + 1).push_back(OHMRrawStats.CPU.at(temp + 1));
-						if (current_cpu.temp.at(core + 1).size() > 20) current_cpu.temp.at(core + 1).pop_front();
+						current_cpu.temp.at(core + 1).trim(20);
 					}
 				}
 			}
@@ -1215,7 +1205,7 @@ namespace Cpu {
 				if (current_gpu != Config::getS("selected_gpu")) {
 					current_gpu = Config::getS("selected_gpu");
 					cpu.gpu_temp.clear();
-					cpu.cpu_percent.at("gpu").clear();
+					cpu.cpu_percent[CFgpu].clear();
 					
 					if (current_gpu != "Auto" and not OHMRrawStats.GPUS.contains(current_gpu)) {
 						current_gpu = "Auto";
@@ -1237,12 +1227,12 @@ namespace Cpu {
 				const auto& gpu = OHMRrawStats.GPUS.contains(current_gpu) ? OHMRrawStats.GPUS.at(current_gpu) : OHMRrawStats.GPUS.at(Config::available_gpus.at(1));
 				gpu_clock = gpu.clock_mhz;
 				cpu.gpu_temp.push_back(gpu.temp);
-				if (cpu.gpu_temp.size() > 40) cpu.gpu_temp.pop_front();
-				cpu.cpu_percent.at("gpu").push_back(gpu.usage);
-				while (cmp_greater(cpu.cpu_percent.at("gpu").size(), width * 2)) cpu.cpu_percent.at("gpu").pop_front();
+				cpu.gpu_temp.trim(40);
+				cpu.cpu_percent[CFgpu].push_back(gpu.usage);
+				cpu.cpu_percent[CFgpu].trim(width * 2);
 			}
 		}
-		else {
+		else if (not Backend::source) {
 			cpuHz = get_cpuHz();
 		}
 	
@@ -1250,72 +1240,37 @@ namespace Cpu {
 		cpu.load_avg[1] = Cpu::load_avg_5m;
 		cpu.load_avg[2] = Cpu::load_avg_15m;
 
-		vector<_SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> sppi(Shared::coreCount);
-		if (not NT_SUCCESS(
-				NtQuerySystemInformation(SystemProcessorPerformanceInformation,
-				&sppi[0],
-				Shared::coreCount * sizeof(_SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION),
-				NULL))){
-			throw std::runtime_error("Failed to run Cpu::collect() -> NtQuerySystemInformation()");
-		}
-
-		vector<long long> idle, kernel, user, interrupt, dpc, total;
-		long long totals;
-		long long cpu_total = 0;
-
-		//? Usage for each core
-		for (int i = 0; i < Shared::coreCount; i++) {
-			user.push_back(sppi[i].UserTime.QuadPart);
-			idle.push_back(sppi[i].IdleTime.QuadPart);
-			kernel.push_back(sppi[i].KernelTime.QuadPart - idle.back());
-			dpc.push_back(sppi[i].Reserved1[0].QuadPart);
-			interrupt.push_back(sppi[i].Reserved1[1].QuadPart);
-			
-
-			totals = 0;
-			for (auto& v : { kernel, user, dpc, interrupt, idle }) totals += v.back();
-			//for (auto& v : { idle, dpc, interrupt }) idles += v.back();
-
-			const long long calc_totals = max(0ll, totals - core_old_totals.at(i));
-			const long long calc_idles = max(0ll, idle.back() - core_old_idles.at(i));
-			core_old_totals.at(i) = totals;
-			core_old_idles.at(i) = idle.back();
-
-			cpu.core_percent.at(i).push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
-			cpu_total += cpu.core_percent.at(i).back();
-
-			//? Reduce size if there are more values than needed for graph
-			if (cpu.core_percent.at(i).size() > 40) cpu.core_percent.at(i).pop_front();
-
-		}
-
-		//? Usage accumulated for total cpu usage
-		vector<long long> times;
-		totals = 0;
-		for (auto& v : { kernel, user, dpc, interrupt, idle}) {
-			times.push_back(std::accumulate(v.cbegin(), v.cend(), 0));
-			totals += times.back();
-		}
-		
-		
-		const long long calc_totals = max(1ll, totals - cpu_old.at("totals"));
-		cpu_old.at("totals") = totals;
-
-		//? Total usage of cpu
-		cpu.cpu_percent.at("total").push_back(clamp(cpu_total / Shared::coreCount, 0ll, 100ll));
-
-		//? Reduce size if there are more values than needed for graph
-		while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
-
-		//? Populate cpu.cpu_percent with all fields from stat
-		for (int ii = 0; const auto& val : times) {
-			cpu.cpu_percent.at(time_names.at(ii)).push_back(clamp((long long)round((double)(val - cpu_old.at(time_names.at(ii))) * 100 / calc_totals), 0ll, 100ll));
-			cpu_old.at(time_names.at(ii)) = val;
-
-			//? Reduce size if there are more values than needed for graph
-			while (cmp_greater(cpu.cpu_percent.at(time_names.at(ii)).size(), width * 2)) cpu.cpu_percent.at(time_names.at(ii)).pop_front();
-			ii++;
+		//? Get raw cpu times from backend if set, otherwise from NtQuerySystemInformation()
+		static Backend::cpu_sample sample;
+		if (Backend::source) {
+			if (not Backend::source->cpu(sample)) return cpu;
+			if (cmp_less(sample.cores.size(), Shared::coreCount))
+				throw std::runtime_error("Cpu::collect() -> Backend " + Backend::source->name() + " returned " + to_string(sample.cores.size()) + " cores, expected " + to_string(Shared::coreCount));
 		}
+		else {
+			static vector<_SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION> sppi;
+			sppi.resize(Shared::coreCount);
+			if (not NT_SUCCESS(
+					NtQuerySystemInformation(SystemProcessorPerformanceInformation,
+					&sppi[0],
+					Shared::coreCount * sizeof(_SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION),
+					NULL))){
+				throw std::runtime_error("Failed to run Cpu::collect() -> NtQuerySystemInformation()");
+			}
+			sample.cores.resize(Shared::coreCount);
+			for (int i = 0; i < Shared::coreCount; i++) {
+				sample.cores[i] = {
+					.kernel = (uint64_t)(sppi[i].KernelTime.QuadPart - sppi[i].IdleTime.QuadPart),
+					.user = (uint64_t)sppi[i].UserTime.QuadPart,
+					.dpc = (uint64_t)sppi[i].Reserved1[0].QuadPart,
+					.interrupt = (uint64_t)sppi[i].Reserved1[1].QuadPart,
+					.idle = (uint64_t)sppi[i].IdleTime.QuadPart
+				};
+			}
+		}
+		if (Backend::recorder) Backend::recorder->write(sample);
+
+		apply_sample(cpu, sample);
 
 		if (Config::getB("show_battery"))
 			current_bat = get_battery();
@@ -1336,6 +1291,7 @@ namespace Mem {
 	mem_info current_mem {};
 
 	int64_t get_totalMem() {
+		if (Backend::source) return totalMem;
 		MEMORYSTATUSEX memstat;
 		memstat.dwLength = sizeof(MEMORYSTATUSEX);
 		if (not GlobalMemoryStatusEx(&memstat)) {
@@ -1344,8 +1300,77 @@ namespace Mem {
 		return static_cast<int64_t>(memstat.ullTotalPhys);
 	}
 
+	//* Get size and io counters for all drives not excluded by <filtered>(mount, name)
+	template<typename F>
+	void _collect_disks(vector<Backend::disk_sample>& out, const F& filtered) {
+		auto free_priv = Config::getB("disk_free_priv");
+		auto& only_physical = Config::getB("only_physical");
+
+		//? Get bitmask containing drives in use
+		DWORD logical_drives = GetLogicalDrives();
+		if (logical_drives == 0) return;
+
+		for (int i = 0; i < 26; i++) {
+			if (not (logical_drives & (1 << i))) continue;
+			string letter = string(1, 'A' + i) + ":\\";
+
+			//? Get device type and continue loop if unknown or failed
+			UINT device_type = GetDriveTypeA(letter.c_str());
+			if (device_type < 2) continue;
+
+			//? Get name of drive
+			string name = "";
+			array<char, MAX_PATH + 1> ch_name;
+			if (GetVolumeInformationA(letter.c_str(), ch_name.data(), MAX_PATH + 1, 0, 0, 0, nullptr, 0))
+				name = string(ch_name.data());
+
+			if (filtered(letter, name)) continue;
+			if (only_physical and device_type != DRIVE_FIXED and device_type != DRIVE_REMOVABLE) continue;
+
+			auto& disk = out.emplace_back();
+			disk.mount = letter;
+			disk.name = name;
+
+			//? Get disk total size and free
+			ULARGE_INTEGER freeBytesCaller, totalBytes, freeBytes;
+			if (GetDiskFreeSpaceExA(letter.c_str(), &freeBytesCaller, &totalBytes, &freeBytes)) {
+				disk.total = totalBytes.QuadPart;
+				disk.free = (free_priv ? freeBytes.QuadPart : freeBytesCaller.QuadPart);
+			}
+
+			//? Get disk IO
+			//! Based on the method used in psutil
+			//! see https://github.com/giampaolo/psutil/blob/master/psutil/arch/windows/disk.c
+			HandleWrapper dHandle(CreateFileW(_bstr_t(string("\\\\.\\" + letter.substr(0, 2)).c_str()), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr));
+			if (dHandle.valid) {
+				DISK_PERFORMANCE diskperf;
+				DWORD retSize = 0;
+				DWORD getSize = sizeof(diskperf);
+				BOOL status;
+				for (int bx = 1; bx < 1024; bx++) {
+					status = DeviceIoControl(dHandle(), IOCTL_DISK_PERFORMANCE, nullptr, 0, &diskperf, getSize, &retSize, nullptr);
+
+					//* DeviceIoControl success
+					if (status != 0) {
+						disk.has_io = true;
+						disk.read = diskperf.BytesRead.QuadPart;
+						disk.write = diskperf.BytesWritten.QuadPart;
+						disk.io_time = diskperf.ReadTime.QuadPart + diskperf.WriteTime.QuadPart;
+					}
+
+					//! DeviceIoControl fail
+					else if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+						getSize *= 2;
+						continue;
+					}
+					break;
+				}
+			}
+		}
+	}
+
 	auto collect(const bool no_update) -> mem_info& {
-		if (Runner::stopping or (no_update and not current_mem.percent.at("used").empty())) return current_mem;
+		if (Runner::stopping or (no_update and not current_mem.percent[MSused].empty())) return current_mem;
 		
 		auto& show_swap = Config::getB("show_page");
 		auto& show_disks = Config::getB("show_disks");
@@ -1367,60 +1392,96 @@ namespace Mem {
 			const auto& gpu = Cpu::OHMRrawStats.GPUS.contains(Cpu::current_gpu) ? Cpu::OHMRrawStats.GPUS.at(Cpu::current_gpu) : Cpu::OHMRrawStats.GPUS.at(Config::available_gpus.at(1));
 			const uint64_t conf_gpu_total = (int64_t)Config::getI("gpu_mem_override") << 20;
 			if (conf_gpu_total > 0 and conf_gpu_total > gpu.mem_used) {
-				mem.stats.at("gpu_total") = conf_gpu_total;
+				mem.stats[MSgpu_total] = conf_gpu_total;
 			}
 			else if (gpu.mem_total < 1) {
-				if (mem.stats.at("gpu_total") < gpu.mem_used) mem.stats.at("gpu_total") = gpu.mem_used;
+				if (mem.stats[MSgpu_total] < gpu.mem_used) mem.stats[MSgpu_total] = gpu.mem_used;
 			}
 			else {
-				mem.stats.at("gpu_total") = gpu.mem_total;
+				mem.stats[MSgpu_total] = gpu.mem_total;
 			}
-			mem.stats.at("gpu_used") = gpu.mem_used;
-			mem.stats.at("gpu_free") = mem.stats.at("gpu_total") - mem.stats.at("gpu_used");
+			mem.stats[MSgpu_used] = gpu.mem_used;
+			mem.stats[MSgpu_free] = mem.stats[MSgpu_total] - mem.stats[MSgpu_used];
 			cpu_gpu = gpu.cpu_gpu;
-			for (const auto name : { "gpu_used", "gpu_free" }) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("gpu_total")));
-				while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+			for (const auto field : { MSgpu_used, MSgpu_free }) {
+				mem.percent[field].push_back(round((double)mem.stats[field] * 100 / mem.stats[MSgpu_total]));
+				mem.percent[field].trim(width * 2);
 			}
 		}
 
-		MEMORYSTATUSEX memstat;
-		memstat.dwLength = sizeof(MEMORYSTATUSEX);
-		PERFORMACE_INFORMATION perfinfo;
-		
-		if (not GlobalMemoryStatusEx(&memstat)) {
-			throw std::runtime_error("Failed to run Mem::collect() -> GlobalMemoryStatusEx()");
-		}
-		if (not GetPerformanceInfo(&perfinfo, sizeof(PERFORMANCE_INFORMATION))) {
-			throw std::runtime_error("Failed to run Mem::collect() -> GetPerformanceInfo()");
+		auto& disks_filter = Config::getS("disks_filter");
+		bool filter_exclude = false;
+		vector<string> filter;
+		if (show_disks and not disks_filter.empty()) {
+			filter = ssplit(disks_filter);
+			if (filter.at(0).starts_with("exclude=")) {
+				filter_exclude = true;
+				filter.at(0) = filter.at(0).substr(8);
+			}
 		}
+		auto disk_filtered = [&](const string& mount, const string& name) {
+			if (filter.empty()) return false;
+			const bool match = v_contains(filter, mount) or (not name.empty() and v_contains(filter, name));
+			return (filter_exclude and match) or (not filter_exclude and not match);
+		};
 
-		totalMem = static_cast<int64_t>(memstat.ullTotalPhys);
-		const int64_t totalCommit = perfinfo.CommitLimit * perfinfo.PageSize;
-		mem.stats.at("available") = static_cast<int64_t>(memstat.ullAvailPhys);
-		mem.stats.at("used") = totalMem * memstat.dwMemoryLoad / 100;
-		mem.stats.at("cached") = perfinfo.SystemCache * perfinfo.PageSize;
-		mem.stats.at("commit") = perfinfo.CommitTotal * perfinfo.PageSize;
-
-		mem.stats.at("page_total") = static_cast<int64_t>(memstat.ullTotalPageFile) - totalMem;
-		mem.stats.at("page_free") = static_cast<int64_t>(memstat.ullAvailPageFile);
-		if (mem.pagevirt or mem.stats.at("page_total") < mem.stats.at("page_free")) {
-			mem.stats.at("page_total") += mem.stats.at("page_free");
+		//? Get raw memory and disk stats from backend if set, otherwise from the Win32 api
+		static Backend::mem_sample sample;
+		if (Backend::source) {
+			if (not Backend::source->mem(sample)) return mem;
+		}
+		else {
+			MEMORYSTATUSEX memstat;
+			memstat.dwLength = sizeof(MEMORYSTATUSEX);
+			PERFORMACE_INFORMATION perfinfo;
+			
+			if (not GlobalMemoryStatusEx(&memstat)) {
+				throw std::runtime_error("Failed to run Mem::collect() -> GlobalMemoryStatusEx()");
+			}
+			if (not GetPerformanceInfo(&perfinfo, sizeof(PERFORMANCE_INFORMATION))) {
+				throw std::runtime_error("Failed to run Mem::collect() -> GetPerformanceInfo()");
+			}
+
+			sample.total = memstat.ullTotalPhys;
+			sample.available = memstat.ullAvailPhys;
+			sample.used = sample.total * memstat.dwMemoryLoad / 100;
+			sample.cached = perfinfo.SystemCache * perfinfo.PageSize;
+			sample.commit = perfinfo.CommitTotal * perfinfo.PageSize;
+			sample.commit_limit = perfinfo.CommitLimit * perfinfo.PageSize;
+			sample.page_total = memstat.ullTotalPageFile - memstat.ullTotalPhys;
+			sample.page_free = memstat.ullAvailPageFile;
+			sample.timestamp = GetTickCount64();
+			sample.disks.clear();
+			if (show_disks) _collect_disks(sample.disks, disk_filtered);
+		}
+		if (Backend::recorder) Backend::recorder->write(sample);
+
+		totalMem = static_cast<int64_t>(sample.total);
+		const int64_t totalCommit = static_cast<int64_t>(sample.commit_limit);
+		mem.stats[MSavailable] = static_cast<int64_t>(sample.available);
+		mem.stats[MSused] = static_cast<int64_t>(sample.used);
+		mem.stats[MScached] = static_cast<int64_t>(sample.cached);
+		mem.stats[MScommit] = static_cast<int64_t>(sample.commit);
+
+		mem.stats[MSpage_total] = static_cast<int64_t>(sample.page_total);
+		mem.stats[MSpage_free] = static_cast<int64_t>(sample.page_free);
+		if (mem.pagevirt or mem.stats[MSpage_total] < mem.stats[MSpage_free]) {
+			mem.stats[MSpage_total] += mem.stats[MSpage_free];
 			mem.pagevirt = true;
 		}
-		mem.stats.at("page_used") = mem.stats.at("page_total") - mem.stats.at("page_free");
+		mem.stats[MSpage_used] = mem.stats[MSpage_total] - mem.stats[MSpage_free];
 
 		//? Calculate percentages
-		for (const string name : { "used", "available", "cached", "commit"}) {
-			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / (name == "commit" ? totalCommit : totalMem)));
-			while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+		for (const auto field : { MSused, MSavailable, MScached, MScommit }) {
+			mem.percent[field].push_back(round((double)mem.stats[field] * 100 / (field == MScommit ? totalCommit : totalMem)));
+			mem.percent[field].trim(width * 2);
 		}
 		
 
-		if (show_swap and mem.stats.at("page_total") > 0) {
-			for (const auto name : {"page_used", "page_free"}) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("page_total")));
-				while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+		if (show_swap and mem.stats[MSpage_total] > 0) {
+			for (const auto field : { MSpage_used, MSpage_free }) {
+				mem.percent[field].push_back(round((double)mem.stats[field] * 100 / mem.stats[MSpage_total]));
+				mem.percent[field].trim(width * 2);
 			}
 			has_swap = true;
 		}
@@ -1429,120 +1490,59 @@ namespace Mem {
 
 		//? Get disks stats
 		if (show_disks) {
-			uint64_t systime = GetTickCount64();
-			auto free_priv = Config::getB("disk_free_priv");
-			auto& disks_filter = Config::getS("disks_filter");
-			bool filter_exclude = false;
-			auto& only_physical = Config::getB("only_physical");
+			const uint64_t systime = sample.timestamp;
 			auto& disks = mem.disks;
 			disk_ios = 0;
 
-			vector<string> filter;
-			if (not disks_filter.empty()) {
-				filter = ssplit(disks_filter);
-				if (filter.at(0).starts_with("exclude=")) {
-					filter_exclude = true;
-					filter.at(0) = filter.at(0).substr(8);
-				}
-			}
-
-			//? Get bitmask containing drives in use
-			DWORD logical_drives = GetLogicalDrives();
-			if (logical_drives == 0) return mem;
-			
 			vector<string> found;
-			found.reserve(last_found.size());			
-			for (int i = 0; i < 26; i++) {
-				if (not (logical_drives & (1 << i))) continue;
-				string letter = string(1, 'A' + i) + ":\\";
-				
-				//? Get device type and continue loop if unknown or failed
-				UINT device_type = GetDriveTypeA(letter.c_str());
-				if (device_type < 2) continue;
-
-				//? Get name of drive
-				string name = "";
-				array<char, MAX_PATH + 1> ch_name;
-				if (GetVolumeInformationA(letter.c_str(), ch_name.data(), MAX_PATH + 1, 0, 0, 0, nullptr, 0))
-					name = string(ch_name.data());
-				
-				//? Match filter if not empty
-				if (not filter.empty()) {
-					bool match = v_contains(filter, letter) or (not name.empty() and v_contains(filter, name));
-					if ((filter_exclude and match) or (not filter_exclude and not match))
-						continue;
+			found.reserve(last_found.size());
+			for (const auto& d : sample.disks) {
+				if (disk_filtered(d.mount, d.name)) continue;
+				found.push_back(d.mount);
+
+				if (not disks.contains(d.mount))
+					disks[d.mount] = { d.name };
+				else
+					disks.at(d.mount).name = d.name;
+
+				auto& disk = disks.at(d.mount);
+
+				//? Disk total size, free and used
+				if (d.total > 0) {
+					disk.total = d.total;
+					disk.free = d.free;
+					disk.used = disk.total - disk.free;
+					disk.used_percent = round((double)disk.used * 100 / disk.total);
+					disk.free_percent = 100 - disk.used_percent;
 				}
 
-				if (not only_physical or (only_physical and (device_type == DRIVE_FIXED or device_type == DRIVE_REMOVABLE))) {
-					found.push_back(letter);
+				//? Disk IO
+				if (d.has_io) {
+					disk_ios++;
 
-					if (not disks.contains(letter))
-						disks[letter] = { name };
+					//? Read
+					if (disk.io_read.empty())
+						disk.io_read.push_back(0);
 					else
-						disks.at(letter).name = name;
-
-					auto& disk = disks.at(letter);
-
-					//? Get disk total size, free and used
-					ULARGE_INTEGER freeBytesCaller, totalBytes, freeBytes;
-					if (GetDiskFreeSpaceExA(letter.c_str(), &freeBytesCaller, &totalBytes, &freeBytes)) {
-						disk.total = totalBytes.QuadPart;
-						disk.free = (free_priv ? freeBytes.QuadPart : freeBytesCaller.QuadPart);
-						disk.used = disk.total - disk.free;
-						disk.used_percent = round((double)disk.used * 100 / disk.total);
-						disk.free_percent = 100 - disk.used_percent;
-					}
+						disk.io_read.push_back(max((int64_t)0, (int64_t)(d.read - disk.old_io.at(0))));
+					disk.old_io.at(0) = d.read;
+					disk.io_read.trim(width * 2);
 
-					//? Get disk IO
-					//! Based on the method used in psutil
-					//! see https://github.com/giampaolo/psutil/blob/master/psutil/arch/windows/disk.c
-					HandleWrapper dHandle(CreateFileW(_bstr_t(string("\\\\.\\" + letter.substr(0, 2)).c_str()), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr));
-					if (dHandle.valid) {
-						DISK_PERFORMANCE diskperf;
-						DWORD retSize = 0;
-						DWORD getSize = sizeof(diskperf);
-						BOOL status;
-						for (int bx = 1; bx < 1024; bx++) {
-							status = DeviceIoControl(dHandle(), IOCTL_DISK_PERFORMANCE, nullptr, 0, &diskperf, getSize, &retSize, nullptr);
-							
-							//* DeviceIoControl success
-							if (status != 0) {
-								disk_ios++;
-								
-								//? Read
-								if (disk.io_read.empty())
-									disk.io_read.push_back(0);
-								else
-									disk.io_read.push_back(max((int64_t)0, (diskperf.BytesRead.QuadPart - disk.old_io.at(0))));
-								disk.old_io.at(0) = diskperf.BytesRead.QuadPart;
-								while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
-
-								//? Write
-								if (disk.io_write.empty())
-									disk.io_write.push_back(0);
-								else
-									disk.io_write.push_back(max((int64_t)0, (diskperf.BytesWritten.QuadPart - disk.old_io.at(1))));
-								disk.old_io.at(1) = diskperf.BytesWritten.QuadPart;
-								while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
-
-								//? IO%
-								int64_t io_time = diskperf.ReadTime.QuadPart + diskperf.WriteTime.QuadPart;
-								if (disk.io_activity.empty())
-									disk.io_activity.push_back(0);
-								else
-									disk.io_activity.push_back(clamp((long)round((double)(io_time - disk.old_io.at(2)) / 1000 / (systime - old_systime)), 0l, 100l));
-								disk.old_io.at(2) = io_time;
-								while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
-							}
-							
-							//! DeviceIoControl fail
-							else if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
-								getSize *= 2;
-								continue;
-							}
-							break;
-						}
-					}
+					//? Write
+					if (disk.io_write.empty())
+						disk.io_write.push_back(0);
+					else
+						disk.io_write.push_back(max((int64_t)0, (int64_t)(d.write - disk.old_io.at(1))));
+					disk.old_io.at(1) = d.write;
+					disk.io_write.trim(width * 2);
+
+					//? IO%
+					if (disk.io_activity.empty())
+						disk.io_activity.push_back(0);
+					else
+						disk.io_activity.push_back(clamp((long)round((double)(int64_t)(d.io_time - disk.old_io.at(2)) / 1000 / max((uint64_t)1, systime - old_systime)), 0l, 100l));
+					disk.old_io.at(2) = d.io_time;
+					disk.io_activity.trim(width * 2);
 				}
 			}
 			old_systime = systime;
@@ -1574,11 +1574,75 @@ namespace Net {
 	vector<string> failed;
 	string selected_iface;
 	int errors = 0;
-	unordered_flat_map<string, uint64_t> graph_max = { {"download", {}}, {"upload", {}} };
-	unordered_flat_map<string, array<int, 2>> max_count = { {"download", {}}, {"upload", {}} };
+	array<uint64_t, NDcount> graph_max = {};
+	array<array<int, 2>, NDcount> max_count = {};
 	bool rescale = true;
 	uint64_t timestamp = 0;
 
+	//* Get addresses and byte counters for all network adapters
+	//! Much of the following code is based on the implementation used in psutil
+	//! See: https://github.com/giampaolo/psutil/blob/master/psutil/arch/windows/net.c
+	void _collect_ifaces(vector<Backend::iface_sample>& out) {
+		out.clear();
+
+		//? Get list of adapters
+		ULONG bufSize = 0;
+		if (GetAdaptersAddresses(AF_UNSPEC, 0, nullptr, nullptr, &bufSize) != ERROR_BUFFER_OVERFLOW) {
+			throw std::runtime_error("Net::collect() -> GetAdaptersAddresses() failed to get buffer size!");
+		}
+
+		auto adapters = std::unique_ptr<IP_ADAPTER_ADDRESSES, decltype(std::free)*>{reinterpret_cast<IP_ADAPTER_ADDRESSES*>(std::malloc(bufSize)), std::free};
+		if (GetAdaptersAddresses(AF_UNSPEC, 0, nullptr, adapters.get(), &bufSize)) {
+			throw std::runtime_error("Net::collect() -> GetAdaptersAddresses() failed to get adapter list!");
+		}
+
+		//? Iterate through list of adapters
+		for (auto a = adapters.get(); a != nullptr; a = a->Next) {
+			auto& iface = out.emplace_back();
+			iface.name = bstr2str(a->FriendlyName);
+			iface.connected = (a->OperStatus == IfOperStatusUp);
+
+			//? Get IP adresses associated with adapter
+			bool ip4 = false, ip6 = false;
+			for (auto u = a->FirstUnicastAddress; u != nullptr and not ip4; u = u->Next) {
+				auto family = u->Address.lpSockaddr->sa_family;
+				if (family == AF_INET and not ip4) {
+					auto sa_in = reinterpret_cast<sockaddr_in*>(u->Address.lpSockaddr);
+					array<char, 256> ipAddress;
+					if (inet_ntop(AF_INET, &sa_in->sin_addr, ipAddress.data(), 256) == NULL)
+						continue;
+					iface.ipv4 = string(ipAddress.data());
+					ip4 = not iface.ipv4.empty();
+				}
+				else if (family == AF_INET6 and not ip6) {
+					auto sa_in = reinterpret_cast<sockaddr_in6*>(u->Address.lpSockaddr);
+					array<char, 256> ipAddress;
+					if (inet_ntop(AF_INET6, &sa_in->sin6_addr, ipAddress.data(), 256) == NULL)
+						continue;
+					iface.ipv6 = string(ipAddress.data());
+					ip6 = not iface.ipv6.empty();
+				}
+				else
+					continue;
+			}
+
+			//? Get IO stats for adapter
+			MIB_IF_ROW2 ifEntry;
+			SecureZeroMemory((PVOID)&ifEntry, sizeof(MIB_IF_ROW2));
+			ifEntry.InterfaceIndex = a->IfIndex;
+			if (GetIfEntry2(&ifEntry) != NO_ERROR) {
+				if (not v_contains(failed, iface.name)) {
+					failed.push_back(iface.name);
+					Logger::debug("Failed to get IO stats for network adapter: " + iface.name);
+				}
+				continue;
+			}
+			iface.has_io = true;
+			iface.rx = ifEntry.InOctets;
+			iface.tx = ifEntry.OutOctets;
+		}
+	}
+
 	auto collect(const bool no_update) -> net_info& {
 		auto& net = current_net;
 
@@ -1587,69 +1651,33 @@ namespace Net {
 		auto& net_auto = Config::getB("net_auto");
 		auto new_timestamp = time_ms();
 
-		//! Much of the following code is based on the implementation used in psutil
-		//! See: https://github.com/giampaolo/psutil/blob/master/psutil/arch/windows/net.c
 		if (not no_update) {
-			//? Get list of adapters
-			ULONG bufSize = 0;
-			if (GetAdaptersAddresses(AF_UNSPEC, 0, nullptr, nullptr, &bufSize) != ERROR_BUFFER_OVERFLOW) {
-				throw std::runtime_error("Net::collect() -> GetAdaptersAddresses() failed to get buffer size!");
+			//? Get raw interface counters from backend if set, otherwise from the Win32 api
+			static Backend::net_sample sample;
+			if (Backend::source) {
+				if (not Backend::source->net(sample)) return empty_net;
 			}
-		
-			auto adapters = std::unique_ptr<IP_ADAPTER_ADDRESSES, decltype(std::free)*>{reinterpret_cast<IP_ADAPTER_ADDRESSES*>(std::malloc(bufSize)), std::free};
-			if (GetAdaptersAddresses(AF_UNSPEC, 0, nullptr, adapters.get(), &bufSize)) {
-				throw std::runtime_error("Net::collect() -> GetAdaptersAddresses() failed to get adapter list!");
+			else {
+				_collect_ifaces(sample.ifaces);
 			}
+			if (Backend::recorder) Backend::recorder->write(sample);
 
 			interfaces.clear();
 
 			//? Iterate through list of adapters
-			for (auto a = adapters.get(); a != nullptr; a = a->Next) {
-				string iface = bstr2str(a->FriendlyName);
+			for (const auto& a : sample.ifaces) {
+				const string& iface = a.name;
 				interfaces.push_back(iface);
-				net[iface].connected = (a->OperStatus == IfOperStatusUp);
-			
-				//? Get IP adresses associated with adapter
-				bool ip4 = false, ip6 = false;
-				for (auto u = a->FirstUnicastAddress; u != nullptr and not ip4; u = u->Next) {
-					auto family = u->Address.lpSockaddr->sa_family;
-					if (family == AF_INET and not ip4) {
-						auto sa_in = reinterpret_cast<sockaddr_in*>(u->Address.lpSockaddr);
-						array<char, 256> ipAddress;
-						if (inet_ntop(AF_INET, &sa_in->sin_addr, ipAddress.data(), 256) == NULL)
-							continue;
-						net[iface].ipv4 = string(ipAddress.data());
-						ip4 = not net[iface].ipv4.empty();
-					}
-					else if (family == AF_INET6 and not ip6) {
-						auto sa_in = reinterpret_cast<sockaddr_in6*>(u->Address.lpSockaddr);
-						array<char, 256> ipAddress;
-						if (inet_ntop(AF_INET6, &sa_in->sin6_addr, ipAddress.data(), 256) == NULL)
-							continue;
-						net[iface].ipv6 = string(ipAddress.data());
-						ip6 = not net[iface].ipv6.empty();
-					}
-					else
-						continue;
-				}
+				net[iface].connected = a.connected;
+				if (not a.ipv4.empty()) net[iface].ipv4 = a.ipv4;
+				if (not a.ipv6.empty()) net[iface].ipv6 = a.ipv6;
+				if (not a.has_io) continue;
 
-				//? Get IO stats for adapter
-				MIB_IF_ROW2 ifEntry;
-				SecureZeroMemory((PVOID)&ifEntry, sizeof(MIB_IF_ROW2));
-				ifEntry.InterfaceIndex = a->IfIndex;
-				if (GetIfEntry2(&ifEntry) != NO_ERROR) {
-					if (not v_contains(failed, iface)) {
-						failed.push_back(iface);
-						Logger::debug("Failed to get IO stats for network adapter: " + iface);
-					}
-					continue;
-				}
+				for (const auto dir : { NDdownload, NDupload }) {
+					auto& saved_stat = net.at(iface).stat[dir];
+					auto& bandwidth = net.at(iface).bandwidth[dir];
 
-				for (const string dir : {"download", "upload"}) {
-					auto& saved_stat = net.at(iface).stat.at(dir);
-					auto& bandwidth = net.at(iface).bandwidth.at(dir);
-
-					uint64_t val = (dir == "download" ? ifEntry.InOctets : ifEntry.OutOctets);
+					uint64_t val = (dir == NDdownload ? a.rx : a.tx);
 
 					//? Update speed, total and top values
 					if (val < saved_stat.last) {
@@ -1668,7 +1696,7 @@ namespace Net {
 
 					//? Add values to graph
 					bandwidth.push_back(saved_stat.speed);
-					while (cmp_greater(bandwidth.size(), width * 2)) bandwidth.pop_front();
+					bandwidth.trim(width * 2);
 
 					//? Set counters for auto scaling
 					if (net_auto and selected_iface == iface) {
@@ -1704,7 +1732,7 @@ namespace Net {
 
 		//? Find an interface to display if selected isn't set or valid
 		if (selected_iface.empty() or not v_contains(interfaces, selected_iface)) {
-			max_count["download"][0] = max_count["download"][1] = max_count["upload"][0] = max_count["upload"][1] = 0;
+			max_count = {};
 			redraw = true;
 			if (net_auto) rescale = true;
 			if (not config_iface.empty() and v_contains(interfaces, config_iface)) selected_iface = config_iface;
@@ -1712,8 +1740,8 @@ namespace Net {
 				//? Sort interfaces by total upload + download bytes
 				auto sorted_interfaces = interfaces;
 				rng::sort(sorted_interfaces, [&](const auto& a, const auto& b){
-					return 	cmp_greater(net.at(a).stat["download"].total + net.at(a).stat["upload"].total,
-										net.at(b).stat["download"].total + net.at(b).stat["upload"].total);
+					return 	cmp_greater(net.at(a).stat[NDdownload].total + net.at(a).stat[NDupload].total,
+										net.at(b).stat[NDdownload].total + net.at(b).stat[NDupload].total);
 				});
 				//? Try to set to a connected interface
 				selected_iface.clear();
@@ -1730,14 +1758,16 @@ namespace Net {
 		//? Calculate max scale for graphs if needed
 		if (net_auto) {
 			bool sync = false;
-			for (const auto& dir: {"download", "upload"}) {
-				if (net_sync and net[selected_iface].stat[dir].speed < net[selected_iface].stat[(string(dir) == "upload" ? "download" : "upload")].speed)
+			auto& sel_net = net[selected_iface];
+			for (const auto dir : { NDdownload, NDupload }) {
+				const auto other = (dir == NDupload ? NDdownload : NDupload);
+				if (net_sync and sel_net.stat[dir].speed < sel_net.stat[other].speed)
 					continue;
 				for (const auto& sel : {0, 1}) {
 					if (rescale or max_count[dir][sel] >= 5) {
-						const uint64_t avg_speed = (net[selected_iface].bandwidth[dir].size() > 5
-							? std::accumulate(net.at(selected_iface).bandwidth.at(dir).rbegin(), net.at(selected_iface).bandwidth.at(dir).rbegin() + 5, 0) / 5
-							: net[selected_iface].stat[dir].speed);
+						const uint64_t avg_speed = (sel_net.bandwidth[dir].size() > 5
+							? std::accumulate(sel_net.bandwidth[dir].end() - 5, sel_net.bandwidth[dir].end(), 0ll) / 5
+							: sel_net.stat[dir].speed);
 						graph_max[dir] = max(uint64_t(avg_speed * (sel == 0 ? 1.3 : 3.0)), (uint64_t)10 << 10);
 						max_count[dir][0] = max_count[dir][1] = 0;
 						redraw = true;
@@ -1747,7 +1777,6 @@ namespace Net {
 				}
 				//? Sync download/upload graphs if enabled
 				if (sync) {
-					const auto other = (string(dir) == "upload" ? "download" : "upload");
 					graph_max[other] = graph_max[dir];
 					max_count[other][0] = max_count[other][1] = 0;
 					break;
@@ -1764,188 +1793,23 @@ namespace Proc {
 
 	vector<proc_info> current_procs;
 	vector<proc_info> current_svcs;
+
+	//? Positions in current_svcs by service name, records only move when missing services are cleared
+	unordered_flat_map<string, size_t> svc_index;
+
 	bool services_swap = false;
-	unordered_flat_map<string, string> uid_user;
+
+	//? Account names by binary SID for successful lookups, cleared when full since LookupAccountSid() can be slow for domain accounts
+	unordered_flat_map<string, string> sid_user;
+	constexpr size_t sid_user_max = 256;
 	string current_sort;
 	string current_filter;
 	bool current_rev = false;
 
 	fs::file_time_type passwd_time;
 
-	uint64_t cputimes = 0;
-	int collapse = -1, expand = -1;
-	uint64_t old_cputimes = 0;
-	atomic<int> numpids = 0;
-	int filter_found = 0;
-
 	detail_container detailed;
 
-	struct tree_proc {
-		std::reference_wrapper<proc_info> entry;
-		vector<tree_proc> children;
-	};
-
-	void proc_sorter(vector<proc_info>& proc_vec, string sorting, const bool reverse, const bool tree = false, const bool services = false) {
-		if (services) {
-			if (sorting == "service") sorting = "program";
-			else if (sorting == "caption") sorting = "command";
-			else if (sorting == "status") sorting = "user";
-		}
-		if (reverse) {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::less{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::less{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::less{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::less{}, &proc_info::user);		break;
-			case 5: rng::stable_sort(proc_vec, rng::less{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_p);		break;
-			case 7: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_c);		break;
-			}
-		}
-		else {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::user); 		break;
-			case 5: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_p);   	break;
-			case 7: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_c);   	break;
-			}
-		}
-
-		//* When sorting with "cpu lazy" push processes over threshold cpu usage to the front regardless of cumulative usage
-		if (not tree and not reverse and sorting == "cpu lazy") {
-			double max = 10.0, target = 30.0;
-			for (size_t i = 0, x = 0, offset = 0; i < proc_vec.size(); i++) {
-				if (i <= 5 and proc_vec.at(i).cpu_p > max)
-					max = proc_vec.at(i).cpu_p;
-				else if (i == 6)
-					target = (max > 30.0) ? max : 10.0;
-				if (i == offset and proc_vec.at(i).cpu_p > 30.0)
-					offset++;
-				else if (proc_vec.at(i).cpu_p > target) {
-					rotate(proc_vec.begin() + offset, proc_vec.begin() + i, proc_vec.begin() + i + 1);
-					if (++x > 10) break;
-				}
-			}
-		}
-	}
-
-	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, const bool reverse, int& c_index, const int index_max, const bool collapsed = false) {
-		if (proc_vec.size() > 1) {
-			if (reverse) {
-				switch (v_index(sort_vector, sorting)) {
-				case 3: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().threads < b.entry.get().threads; });	break;
-				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem < b.entry.get().mem; });	break;
-				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p < b.entry.get().cpu_p; });	break;
-				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c < b.entry.get().cpu_c; });	break;
-				}
-			}
-			else {
-				switch (v_index(sort_vector, sorting)) {
-				case 3: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().threads > b.entry.get().threads; });	break;
-				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem > b.entry.get().mem; });	break;
-				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p > b.entry.get().cpu_p; });	break;
-				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c > b.entry.get().cpu_c; });	break;
-				}
-			}
-		}
-
-		for (auto& r : proc_vec) {
-			r.entry.get().tree_index = (collapsed or r.entry.get().filtered ? index_max : c_index++);
-			if (not r.children.empty()) {
-				tree_sort(r.children, sorting, reverse, c_index, (collapsed or r.entry.get().collapsed or r.entry.get().tree_index == index_max));
-			}
-		}
-	}
-
-	//* Generate process tree list
-	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs, int cur_depth, const bool collapsed, const string& filter, bool found=false, const bool no_update=false, const bool should_filter=false) {
-		auto cur_pos = out_procs.size();
-		bool filtering = false;
-
-		//? If filtering, include children of matching processes
-		if (not found and (should_filter or not filter.empty())) {
-			if (not s_contains(std::to_string(cur_proc.pid), filter)
-			and not s_contains_ic(cur_proc.name, filter)
-			and not s_contains_ic(cur_proc.cmd, filter)
-			and not s_contains_ic(cur_proc.user, filter)) {
-				filtering = true;
-				cur_proc.filtered = true;
-				filter_found++;
-			}
-			else {
-				found = true;
-				cur_depth = 0;
-			}
-		}
-		else if (cur_proc.filtered) cur_proc.filtered = false;
-
-		cur_proc.depth = cur_depth;
-
-		//? Set tree index position for process if not filtered out or currently in a collapsed sub-tree
-		out_procs.push_back({ cur_proc });
-		if (not collapsed and not filtering) {
-			cur_proc.tree_index = out_procs.size() - 1;
-			
-			//? Try to find name of the binary file and append to program name if not the same
-			if (cur_proc.short_cmd.empty() and WMIList.contains(cur_proc.pid)) {
-				string pname = bstr2str(WMIList.at(cur_proc.pid).Name);
-				if (pname.size() < cur_proc.cmd.size()) {
-					std::string_view cmd = cur_proc.cmd;
-					auto ssfind = cmd.find(pname);
-					if (ssfind + pname.size() < cmd.size()) {
-						cmd.remove_prefix(ssfind + pname.size());
-						if (cmd.starts_with(pname)) cmd.remove_prefix(pname.size());
-						if (cmd.starts_with("\"")) cmd.remove_prefix(1);
-						if (cmd.starts_with(" ")) cmd.remove_prefix(1);
-						cur_proc.short_cmd = string(cmd);
-					}
-				}
-
-				if (cur_proc.short_cmd.empty())
-					cur_proc.short_cmd = pname;
-			}
-		}
-		else {
-			cur_proc.tree_index = in_procs.size();
-		}
-
-		//? Recursive iteration over all children
-		int children = 0;
-		for (auto& p : rng::equal_range(in_procs, cur_proc.pid, rng::less{}, &proc_info::ppid)) {
-			if (collapsed and not filtering) {
-				cur_proc.filtered = true;
-			}
-			children++;
-			
-			_tree_gen(p, in_procs, out_procs.back().children, cur_depth + 1, (collapsed or cur_proc.collapsed), filter, found, no_update, should_filter);
-			
-			if (not no_update and not filtering and (collapsed or cur_proc.collapsed)) {
-				//auto& parent = cur_proc;
-				cur_proc.cpu_p += p.cpu_p;
-				cur_proc.cpu_c += p.cpu_c;
-				cur_proc.mem += p.mem;
-				cur_proc.threads += p.threads;
-				filter_found++;
-				p.filtered = true;
-			}
-		}
-		if (collapsed or filtering) {
-			return;
-		}
-
-		//? Add tree terminator symbol if it's the last child in a sub-tree
-		if (children > 0 and not out_procs.back().children.back().entry.get().prefix.ends_with("]─"))
-			out_procs.back().children.back().entry.get().prefix.replace(out_procs.back().children.back().entry.get().prefix.size() - 8, 8, " └─ ");
-
-		//? Add collapse/expand symbols if process have any children
-		out_procs.at(cur_pos).entry.get().prefix = " │ "s * cur_depth + (children > 0 ? (cur_proc.collapsed ? "[+]─" : "[-]─") : " ├─ ");
-	}
-
 	//* Get detailed info for selected process
 	void _collect_details(const size_t pid, const string name, const uint64_t uptime, vector<proc_info>& procs, uint64_t totalMem) {
 		const auto& services = Config::getB("proc_services");
@@ -1979,10 +1843,10 @@ namespace Proc {
 			auto p_info = (services ? rng::find(procs, name, &proc_info::name) : rng::find(procs, pid, &proc_info::pid));
 			detailed.entry = *p_info;
 
-			//? Update cpu percent deque for process cpu graph
+			//? Update cpu percent history for process cpu graph
 			if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
 			detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
-			while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
+			detailed.cpu_percent.trim(width);
 
 			//? Process runtime
 			if (detailed.entry.cpu_s > 0) {
@@ -2002,7 +1866,7 @@ namespace Proc {
 				redraw = true;
 			}
 
-			while (cmp_greater(detailed.mem_bytes.size(), width)) detailed.mem_bytes.pop_front();
+			detailed.mem_bytes.trim(width);
 
 			//? Get bytes read and written
 			if (WMIList.contains(pid)) {
@@ -2054,18 +1918,28 @@ namespace Proc {
 		const int cmult = (per_core) ? Shared::coreCount : 1;
 		bool got_detailed = false;
 
-		static vector<size_t> found;
+		static vector<bool> alive;
 
 		//* Use pids from last update if only changing filter, sorting or tree options
 		if (no_update and not current_procs.empty()) {
-			if (show_detailed and (detailed_pid != detailed.last_pid or detailed_name != detailed.last_name)) {
+			if (show_detailed and not Backend::source and (detailed_pid != detailed.last_pid or detailed_name != detailed.last_name)) {
 				_collect_details(detailed_pid, detailed_name, systime, (services ? current_svcs : current_procs), Mem::get_totalMem());
 			}
 		}
 		//* ---------------------------------------------Collection start----------------------------------------------
+		//? Processes from a collector backend, details for the selected process are only available from the native collector
+		else if (Backend::source) {
+			should_filter = true;
+			static Backend::proc_list sample;
+			if (not Backend::source->procs(sample)) return current_procs;
+			if (Backend::recorder) Backend::recorder->write(sample);
+			apply_sample(current_procs, sample, per_core);
+		}
 		else {
 			should_filter = true;
 			totalMem = Mem::get_totalMem();
+			static Backend::proc_list recorded;
+			recorded.procs.clear();
 
 			//? Get cpu total times
 			if (FILETIME idle, kernel, user; GetSystemTimes(&idle, &kernel, &user)) {
@@ -2078,7 +1952,10 @@ namespace Proc {
 			}
 			
 			//? Iterate over all processes
-			found.clear();
+			tree_remove_totals(current_procs);
+			alive.assign(current_procs.size(), false);
+			proc_index.clear();
+			for (size_t i = 0; i < current_procs.size(); i++) proc_index[current_procs[i].pid] = i;
 			HandleWrapper pSnap(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
 
 			if (not pSnap.valid) {
@@ -2105,33 +1982,72 @@ namespace Proc {
 				HandleWrapper pHandle(OpenProcess(PROCESS_QUERY_INFORMATION, FALSE, pe.th32ProcessID));
 				const bool hasWMI = WMIList.contains(pid);
 				bool wmi_request = (not hasWMI and not Proc::WMI_running);
-				
-				found.push_back(pid);
 
-				//? Check if pid already exists in current_procs
-				auto find_old = rng::find(current_procs, pid, &proc_info::pid);
+				//? Process creation time and cpu times
+				uint64_t created = 0, cpu_t = 0;
+				if (FILETIME createT, exitT, kernelT, userT; pHandle.valid and GetProcessTimes(pHandle(), &createT, &exitT, &kernelT, &userT)) {
+					created = ULARGE_INTEGER{ createT.dwLowDateTime, createT.dwHighDateTime }.QuadPart;
+					cpu_t = ULARGE_INTEGER{ kernelT.dwLowDateTime, kernelT.dwHighDateTime }.QuadPart + ULARGE_INTEGER{ userT.dwLowDateTime, userT.dwHighDateTime }.QuadPart;
+				}
+
+				//? Check if pid already exists in current_procs, cached values are only kept if the creation time matches so a reused pid starts over
+				size_t index;
 				bool no_cache = false;
-				if (find_old == current_procs.end()) {
-					current_procs.push_back({pid});
-					find_old = current_procs.end() - 1;
+				if (auto find_old = proc_index.find(pid); find_old != proc_index.end()) {
+					index = find_old->second;
+					if (auto& old_proc = current_procs[index]; created != 0 and old_proc.created != 0 and old_proc.created != created) {
+						old_proc = {.pid = pid};
+						no_cache = true;
+					}
+				}
+				else {
+					index = current_procs.size();
+					current_procs.push_back({.pid = pid});
+					proc_index[pid] = index;
+					alive.push_back(false);
 					no_cache = true;
 				}
+				alive[index] = true;
 
-				auto& new_proc = *find_old;
+				auto& new_proc = current_procs[index];
+				auto& text = *new_proc.text;
+				if (created != 0) new_proc.created = created;
 
 				//? Cache values that shouldn't change
+				bool key_change = false;
 				if (no_cache or (hasWMI and not new_proc.WMI)) {
+					key_change = true;
 					new_proc.name = bstr2str(pe.szExeFile);
 					new_proc.ppid = pe.th32ParentProcessID;
 
 					if (hasWMI) {
 						if (new_proc.name.empty()) new_proc.name = bstr2str(WMIList.at(pid).Name);
 						if (new_proc.ppid == 0) new_proc.ppid = WMIList.at(pid).ParentProcessId;
-						new_proc.cmd = bstr2str(WMIList.at(pid).CommandLine);
-						if (new_proc.cmd.empty())
-							new_proc.cmd = bstr2str(WMIList.at(pid).ExecutablePath);
+						text.cmd = bstr2str(WMIList.at(pid).CommandLine);
+						if (text.cmd.empty())
+							text.cmd = bstr2str(WMIList.at(pid).ExecutablePath);
+					}
+					if (text.cmd.empty()) text.cmd = new_proc.name;
+
+					//? Arguments after the binary name, shown next to the program name in the tree view
+					text.short_cmd.clear();
+					if (hasWMI) {
+						string pname = bstr2str(WMIList.at(pid).Name);
+						if (pname.size() < text.cmd.size()) {
+							std::string_view cmd = text.cmd;
+							auto ssfind = cmd.find(pname);
+							if (ssfind + pname.size() < cmd.size()) {
+								cmd.remove_prefix(ssfind + pname.size());
+								if (cmd.starts_with(pname)) cmd.remove_prefix(pname.size());
+								if (cmd.starts_with("\"")) cmd.remove_prefix(1);
+								if (cmd.starts_with(" ")) cmd.remove_prefix(1);
+								text.short_cmd = string(cmd);
+							}
+						}
+
+						if (text.short_cmd.empty())
+							text.short_cmd = std::move(pname);
 					}
-					if (new_proc.cmd.empty()) new_proc.cmd = new_proc.name;
 
 					new_proc.name = new_proc.name.substr(0, new_proc.name.find_last_of('.'));
 
@@ -2143,52 +2059,64 @@ namespace Proc {
 							if (dwLength > 0) {
 								std::unique_ptr<BYTE[]> ptu(new BYTE[dwLength]);
 								if (ptu != nullptr and GetTokenInformation(pToken.wHandle, TokenUser, ptu.get(), dwLength, &dwLength)) {
-									SID_NAME_USE SidType;
-									wchar_t lpName[260];
-									wchar_t lpDomain[260];
-									DWORD dwSize = 260;
-									if (LookupAccountSid(0, ((PTOKEN_USER)ptu.get())->User.Sid, lpName, &dwSize, lpDomain, &dwSize, &SidType)) {
-										new_proc.user = bstr2str(lpName);
-										if (new_proc.user.empty())
-											new_proc.user = bstr2str(lpDomain);
+									const PSID sid = ((PTOKEN_USER)ptu.get())->User.Sid;
+									string sid_key((const char*)sid, GetLengthSid(sid));
+									if (auto cached = sid_user.find(sid_key); cached != sid_user.end()) {
+										text.user = cached->second;
+									}
+									else {
+										SID_NAME_USE SidType;
+										wchar_t lpName[260];
+										wchar_t lpDomain[260];
+										DWORD dwSize = 260;
+										if (LookupAccountSid(0, sid, lpName, &dwSize, lpDomain, &dwSize, &SidType)) {
+											text.user = bstr2str(lpName);
+											if (text.user.empty())
+												text.user = bstr2str(lpDomain);
+
+											//? Failed lookups aren't cached so they are retried for the next process with the same SID
+											if (not text.user.empty()) {
+												if (sid_user.size() >= sid_user_max) sid_user.clear();
+												sid_user[std::move(sid_key)] = text.user;
+											}
+										}
 									}
 								}
 							}
 						}
 					}
-					if (new_proc.user.empty() and pid < 1000) new_proc.user = "SYSTEM";
+					if (text.user.empty() and pid < 1000) text.user = "SYSTEM";
 					new_proc.WMI = hasWMI;
 				}
 
 				//? Use parent process username if empty
-				if (not no_cache and new_proc.user.empty()) {
+				if (not no_cache and text.user.empty()) {
 					if (new_proc.ppid != 0) {
-						if (auto parent = rng::find(current_procs, new_proc.ppid, &proc_info::pid); parent != current_procs.end()) {
-							new_proc.user = parent->user;
+						if (auto parent = proc_index.find(new_proc.ppid); parent != proc_index.end()) {
+							text.user = current_procs[parent->second].text->user;
 						}
 					}
 					else
-						new_proc.user = "SYSTEM";
+						text.user = "SYSTEM";
 
-					if (new_proc.user.empty()) new_proc.user = "******";
+					if (text.user.empty()) text.user = "******";
+					key_change = true;
 				}
 
+				if (key_change) update_search_key(new_proc);
+
 				new_proc.threads = pe.cntThreads;
 
-				uint64_t cpu_t = 0;
 				if (pHandle.valid) {
 					//? Process memory
 					if (PROCESS_MEMORY_COUNTERS_EX pmem; GetProcessMemoryInfo(pHandle(), (PROCESS_MEMORY_COUNTERS *)&pmem, sizeof(PROCESS_MEMORY_COUNTERS_EX))) {
 						new_proc.mem = pmem.PrivateUsage;
 					}
-					
-					//? Process cpu stats
-					if (FILETIME createT, exitT, kernelT, userT; GetProcessTimes(pHandle(), &createT, &exitT, &kernelT, &userT)) {
-						new_proc.cpu_s = ULARGE_INTEGER{ createT.dwLowDateTime, createT.dwHighDateTime }.QuadPart;
-						cpu_t = ULARGE_INTEGER{ kernelT.dwLowDateTime, kernelT.dwHighDateTime }.QuadPart + ULARGE_INTEGER{ userT.dwLowDateTime, userT.dwHighDateTime }.QuadPart;
-					}
 				}
 
+				//? Process cpu stats
+				if (created != 0) new_proc.cpu_s = created;
+
 				//? Process memory fallback to background WMI thread
 				if (new_proc.mem == 0 and hasWMI) {
 					new_proc.mem = _wtoi64(WMIList.at(pid).PrivateMemory);
@@ -2241,11 +2169,18 @@ namespace Proc {
 
 				if (wmi_request) Proc::WMI_requests.push_back(pid);
 
+				if (Backend::recorder)
+					recorded.procs.push_back({pid, new_proc.ppid, new_proc.threads, new_proc.mem, new_proc.created, cpu_t, new_proc.name, text.cmd, text.user});
+
 			} while (Process32Next(pSnap(), &pe));
 
-			//? Clear dead processes from current_procs
-			auto eraser = rng::remove_if(current_procs, [&](const auto& element){ return not v_contains(found, element.pid); });
-			current_procs.erase(eraser.begin(), eraser.end());
+			clear_dead(current_procs, alive);
+
+			if (Backend::recorder) {
+				recorded.cpu_total = cputimes;
+				recorded.systime = systime;
+				Backend::recorder->write(recorded);
+			}
 
 			//? Update the details info box for process if active
 			if (not services and show_detailed and got_detailed) {
@@ -2262,34 +2197,48 @@ namespace Proc {
 		//* Collect info for services using WMI if currently enabled
 		if (services and not no_update) {
 			bool got_detailed = false;
+			svc_index.clear();
+			for (size_t i = 0; i < current_svcs.size(); i++) svc_index[current_svcs[i].name] = i;
+
 			for (const auto& [name, svc] : WMISvcList) {
 				
-				//? Check if pid already exists in current_svcs
-				auto find_old = rng::find(current_svcs, name, &proc_info::name);
-				if (find_old == current_svcs.end()) {
+				//? Check if service already exists in current_svcs
+				size_t index;
+				if (auto find_old = svc_index.find(name); find_old != svc_index.end()) {
+					index = find_old->second;
+				}
+				else {
+					index = current_svcs.size();
 					current_svcs.push_back({});
-					find_old = current_svcs.end() - 1;
+					svc_index[name] = index;
 				}
 
-				auto& new_svc = *find_old;
+				auto& new_svc = current_svcs[index];
+				auto& text = *new_svc.text;
 
 				if (name == detailed_name) {
 					got_detailed = true;
 				}
 
-				new_svc.name = name;
-				new_svc.pid = svc.ProcessID;
-				new_svc.cmd = bstr2str(svc.Caption);
-				new_svc.user = bstr2str(svc.State);
-				if (tree) new_svc.short_cmd = new_svc.cmd;
+				string caption = bstr2str(svc.Caption);
+				string state = bstr2str(svc.State);
+				if (new_svc.pid != svc.ProcessID or new_svc.name != name or text.cmd != caption or text.user != state) {
+					new_svc.name = name;
+					new_svc.pid = svc.ProcessID;
+					text.cmd = std::move(caption);
+					text.user = std::move(state);
+					update_search_key(new_svc);
+				}
+				if (tree) text.short_cmd = text.cmd;
 
 				//? Find pid entry in current_procs
-				if (auto proc = rng::find(current_procs, new_svc.pid, &proc_info::pid); proc != current_procs.end()) {
-					new_svc.cpu_c = proc->cpu_c;
-					new_svc.cpu_p = proc->cpu_p;
-					new_svc.cpu_s = proc->cpu_s;
-					new_svc.mem = proc->mem;
-					new_svc.threads = proc->threads;
+				if (auto find_proc = proc_index.find(new_svc.pid); find_proc != proc_index.end()) {
+					const auto& proc = current_procs[find_proc->second];
+					new_svc.cpu_c = proc.cpu_c;
+					new_svc.cpu_p = proc.cpu_p;
+					new_svc.cpu_s = proc.cpu_s;
+					new_svc.mem = proc.mem;
+					new_svc.threads = proc.threads;
 				}
 				else {
 					new_svc.cpu_c = 0.0;
@@ -2318,95 +2267,8 @@ namespace Proc {
 		//* ---------------------------------------------Collection done-----------------------------------------------
 
 		auto& out_vec = (services ? current_svcs : current_procs);
+		arrange(out_vec, sorting, reverse, filter, tree, services, no_update, should_filter, sorted_change);
 
-		//* Match filter if defined
-		if (should_filter) {
-			filter_found = 0;
-			for (auto& p : out_vec) {
-				if (not tree and not filter.empty()) {
-						if (not s_contains(to_string(p.pid), filter)
-						and not s_contains_ic(p.name, filter)
-						and not s_contains_ic(p.cmd, filter)
-						and not s_contains_ic(p.user, filter)) {
-							p.filtered = true;
-							filter_found++;
-							}
-						else {
-							p.filtered = false;
-						}
-					}
-				else {
-					p.filtered = false;
-				}
-			}
-		}
-
-		//? Sort processes
-		if (sorted_change or not no_update) {
-			proc_sorter(out_vec, sorting, reverse, tree, services);
-		}
-
-		//* Generate tree view if enabled
-		if (tree and not services and (not no_update or should_filter or sorted_change)) {
-			bool locate_selection = false;
-			if (auto find_pid = (collapse != -1 ? collapse : expand); find_pid != -1) {
-				auto collapser = rng::find(out_vec, find_pid, &proc_info::pid);
-				if (collapser != out_vec.end()) {
-					if (collapse == expand) {
-						collapser->collapsed = not collapser->collapsed;
-					}
-					else if (collapse > -1) {
-						collapser->collapsed = true;
-					}
-					else if (expand > -1) {
-						collapser->collapsed = false;
-					}
-					if (Config::ints.at("proc_selected") > 0) locate_selection = true;
-				}
-				collapse = expand = -1;
-			}
-			if (should_filter or not filter.empty()) filter_found = 0;
-
-			vector<tree_proc> tree_procs;
-			tree_procs.reserve(out_vec.size());
-
-			for (auto& p : out_vec) {
-				if (not v_contains(found, p.ppid)) p.ppid = 0;
-			}
-
-			//? Stable sort to retain selected sorting among processes with the same parent
-			rng::stable_sort(out_vec, rng::less{}, & proc_info::ppid);
-
-			//? Start recursive iteration over processes with the lowest shared parent pids
-			for (auto& p : rng::equal_range(out_vec, out_vec.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, out_vec, tree_procs, 0, false, filter, false, no_update, should_filter);
-			}
-
-			//? Recursive sort over tree structure to account for collapsed processes in the tree
-			int index = 0;
-			tree_sort(tree_procs, sorting, reverse, index, out_vec.size());
-
-			//? Add tree begin symbol to first item if childless
-			if (tree_procs.front().children.empty())
-				tree_procs.front().entry.get().prefix.replace(tree_procs.front().entry.get().prefix.size() - 8, 8, " ┌─ ");
-			
-			//? Add tree terminator symbol to last item if childless
-			if (tree_procs.back().children.empty())
-				tree_procs.back().entry.get().prefix.replace(tree_procs.back().entry.get().prefix.size() - 8, 8, " └─ ");
-
-			//? Final sort based on tree index
-			rng::sort(out_vec, rng::less{}, & proc_info::tree_index);
-
-			//? Move current selection/view to the selected process when collapsing/expanding in the tree
-			if (locate_selection) {
-				int loc = rng::find(out_vec, Proc::selected_pid, &proc_info::pid)->tree_index;
-				if (Config::ints.at("proc_start") >= loc or Config::ints.at("proc_start") <= loc - Proc::select_max)
-					Config::ints.at("proc_start") = max(0, loc - 1);
-				Config::ints.at("proc_selected") = loc - Config::ints.at("proc_start") + 1;
-			}
-		}
-
-		numpids = (int)out_vec.size() - filter_found;
 		if (not Proc::WMI_requests.empty()) Proc::WMI_trigger();
 		return out_vec;
 	}
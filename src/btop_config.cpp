@@ -23,6 +23,8 @@ tab-size = 4
 #include <atomic>
 #include <fstream>
 #include <string_view>
+#include <memory>
+#include <deque>
 
 #include <btop_config.hpp>
 #include <btop_shared.hpp>
@@ -36,248 +38,89 @@ using namespace Tools;
 //* Functions and variables for reading and writing the btop config file
 namespace Config {
 
-	atomic<bool> locked (false);
-	atomic<bool> writelock (false);
-	bool write_new;
+	atomic<bool> write_new (false);
 
-	const vector<array<string, 2>> descriptions = {
-		{"color_theme", 		"#* Name of a btop++/bpytop/bashtop formatted \".theme\" file, \"Default\" and \"TTY\" for builtin themes.\n"
-								"#* Themes should be placed in \"themes\" folder in same folder as btop4win.exe"},
+	#define CONFIG_VALUE(name, value, ...) value,
+	#define CONFIG_SKIP(...)
 
-		{"theme_background", 	"#* If the theme set background should be shown, set to False if you want terminal background transparency."},
-
-		{"truecolor", 			"#* Sets if 24-bit truecolor should be used, will convert 24-bit colors to 256 color (6x6x6 color cube) if false."},
-
-		{"force_tty", 			"#* Set to true to force tty mode regardless if a real tty has been detected or not.\n"
-								"#* Will force 16-color mode and TTY theme, set all graph symbols to \"tty\" and swap out other non tty friendly symbols."},
-
-		{"presets",				"#* Define presets for the layout of the boxes. Preset 0 is always all boxes shown with default settings. Max 9 presets.\n"
-								"#* Format: \"box_name:P:G,box_name:P:G\" P=(0 or 1) for alternate positions, G=graph symbol to use for box.\n"
-								"#* Use withespace \" \" as separator between different presets.\n"
-								"#* Example: \"cpu:0:default,mem:0:tty,proc:1:default cpu:0:braille,proc:0:tty\""},
-
-		{"vim_keys",			"#* Set to True to enable \"h,j,k,l,g,G\" keys for directional control in lists.\n"
-								"#* Conflicting keys for h:\"help\" and k:\"kill\" is accessible while holding shift."},
-
-		{"enable_ohmr",			"#* Enables monitoring of CPU temps, accurate CPU clock and GPU via Libre Hardware Monitor.\n"
-								"#* Needs the my DLL's from (https://github.com/aristocratos/LHM-CppExport) installed in same folder as btop4win.exe."},
-
-		{"show_gpu",			"#* Also show gpu stats in cpu and mem box. Needs Libre Hardware Monitor Report enabled."},
-
-		{"selected_gpu",		"#* Which GPU to display if multiple is detected."},
-
-		{"gpu_mem_override",	"#* Manually set and override the GPU total memory shown when not correctly detected. Value in MiB. Example: \"gpu_mem_override = 1024\" for 1 GiB."},
-
-		{"rounded_corners",		"#* Rounded corners on boxes, is ignored if TTY mode is ON."},
-
-		{"graph_symbol", 		"#* Default symbols to use for graph creation, \"braille\", \"block\" or \"tty\".\n"
-								"#* \"braille\" offers the highest resolution but might not be included in all fonts.\n"
-								"#* \"block\" has half the resolution of braille but uses more common characters.\n"
-								"#* \"tty\" uses only 3 different symbols but will work with most fonts and should work in a real TTY.\n"
-								"#* Note that \"tty\" only has half the horizontal resolution of the other two, so will show a shorter historical view."},
-
-		{"graph_symbol_cpu", 	"# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\"."},
-
-		{"graph_symbol_mem", 	"# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\"."},
-
-		{"graph_symbol_net", 	"# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\"."},
-
-		{"graph_symbol_proc", 	"# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\"."},
-
-		{"shown_boxes", 		"#* Manually set which boxes to show. Available values are \"cpu mem net proc\", separate values with whitespace."},
-
-		{"update_ms", 			"#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs."},
-
-		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
-								"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly."},
-		
-		{"proc_services",		"#* Show services in the process box instead of processes."},
-
-		{"services_sorting",	"#* Services sorting, \"service\" \"caption\" \"status\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
-								"#* \"cpu lazy\" sorts top service over time (easier to follow), \"cpu direct\" updates top service directly."},
-
-		{"proc_reversed",		"#* Reverse sorting order, True or False."},
-
-		{"proc_tree",			"#* Show processes as a tree."},
-
-		{"proc_colors", 		"#* Use the cpu graph colors in the process list."},
-
-		{"proc_gradient", 		"#* Use a darkening gradient in the process list."},
-
-		{"proc_per_core", 		"#* If process cpu usage should be of the core it's running on or usage of the total available cpu power."},
-
-		{"proc_mem_bytes", 		"#* Show process memory as bytes instead of percent."},
-
-		{"proc_left",			"#* Show proc box on left side of screen instead of right."},
-
-		{"cpu_graph_upper", 	"#* Sets the CPU stat shown in upper half of the CPU graph, \"total\" is always available.\n"
-								"#* Select from a list of detected attributes from the options menu."},
-
-		{"cpu_graph_lower", 	"#* Sets the CPU stat shown in lower half of the CPU graph, \"total\" is always available.\n"
-								"#* Select from a list of detected attributes from the options menu."},
-
-		{"cpu_invert_lower", 	"#* Toggles if the lower CPU graph should be inverted."},
-
-		{"cpu_single_graph", 	"#* Set to True to completely disable the lower CPU graph."},
-
-		{"cpu_bottom",			"#* Show cpu box at bottom of screen instead of top."},
-
-		{"show_uptime", 		"#* Shows the system uptime in the CPU box."},
-
-		{"check_temp", 			"#* Show cpu temperature."},
-
-		{"cpu_sensor", 			"#* Which sensor to use for cpu temperature, use options menu to select from list of available sensors."},
-
-		{"show_coretemp", 		"#* Show temperatures for cpu cores also if check_temp is True and sensors has been found."},
-
-		{"temp_scale", 			"#* Which temperature scale to use, available values: \"celsius\", \"fahrenheit\", \"kelvin\" and \"rankine\"."},
-
-		{"base_10_sizes",		"#* Use base 10 for bits/bytes sizes, KB = 1000 instead of KiB = 1024."},
-
-		{"clock_format", 		"#* Draw a clock at top of screen, formatting according to strftime, empty string to disable.\n"
-								"#* Special formatting: /host = hostname | /user = username | /uptime = system uptime"},
-
-		{"background_update", 	"#* Update main ui in background when menus are showing, set this to false if the menus is flickering too much for comfort."},
-
-		{"custom_cpu_name", 	"#* Custom cpu model name, empty string to disable."},
-
-		{"disks_filter", 		"#* Optional filter for shown disks, should be full path of a mountpoint, separate multiple values with whitespace \" \".\n"
-								"#* Begin line with \"exclude=\" to change to exclude filter, otherwise defaults to \"most include\" filter. Example: disks_filter=\"exclude=D:\\ E:\\\"."},
-
-		{"mem_graphs", 			"#* Show graphs instead of meters for memory values."},
-
-		{"mem_below_net",		"#* Show mem box below net box instead of above."},
-
-		{"show_page", 			"#* If page memory should be shown in memory box."},
-
-		{"show_disks", 			"#* If mem box should be split to also show disks info."},
-
-		{"only_physical", 		"#* Filter out non physical disks. Set this to False to include network disks, RAM disks and similar."},
-
-		{"disk_free_priv",		"#* Set to true to show available disk space for privileged users."},
-
-		{"show_io_stat", 		"#* Toggles if io activity % (disk busy time) should be shown in regular disk usage view."},
-
-		{"io_mode", 			"#* Toggles io mode for disks, showing big graphs for disk read/write speeds."},
-
-		{"io_graph_combined", 	"#* Set to True to show combined read/write io graphs in io mode."},
-
-		{"io_graph_speeds", 	"#* Set the top speed for the io graphs in MiB/s (100 by default), use format \"device:\\speed\" separate disks with whitespace \" \".\n"
-								"#* Example: \"C:\\100 D:\\20 G:\\1\"."},
-
-		{"net_download", 		"#* Set fixed values for network graphs in Mebibits. Is only used if net_auto is also set to False."},
-
-		{"net_upload", ""},
-
-		{"net_auto", 			"#* Use network graphs auto rescaling mode, ignores any values set above and rescales down to 10 Kibibytes at the lowest."},
+	values live = {
+		{ BTOP_CONFIG_KEYS(CONFIG_VALUE, CONFIG_SKIP, CONFIG_SKIP) },
+		{ BTOP_CONFIG_KEYS(CONFIG_SKIP, CONFIG_VALUE, CONFIG_SKIP) },
+		{ BTOP_CONFIG_KEYS(CONFIG_SKIP, CONFIG_SKIP, CONFIG_VALUE) }
+	};
+	#undef CONFIG_VALUE
+	#undef CONFIG_SKIP
+
+	values snapshot = live;
+	thread_local values* current = &live;
+
+	//? Type, index, name and description of every key in config file order
+	enum Types { Tbool, Tint, Tstring };
+	struct entry { Types type; uint16_t index; string_view name; const char* description; };
+
+	#define CONFIG_BOOL_ENTRY(name, value, description) {Tbool, name, #name, description},
+	#define CONFIG_INT_ENTRY(name, value, description) {Tint, name, #name, description},
+	#define CONFIG_STRING_ENTRY(name, value, description) {Tstring, name, #name, description},
+
+	const vector<entry> entries = { BTOP_CONFIG_KEYS(CONFIG_BOOL_ENTRY, CONFIG_INT_ENTRY, CONFIG_STRING_ENTRY) };
+	#undef CONFIG_BOOL_ENTRY
+	#undef CONFIG_INT_ENTRY
+	#undef CONFIG_STRING_ENTRY
+
+	//* One value set by the runner thread, bools and ints are stored in <number>
+	struct change {
+		Types type;
+		uint16_t index;
+		int number;
+		string text;
+	};
 
-		{"net_sync", 			"#* Sync the auto scaling for download and upload to whichever currently has the highest scale."},
+	//* Values changed by the runner thread during one or more cycles, <seq> is the number of the last cycle included
+	struct change_batch {
+		uint64_t seq;
+		vector<change> changes;
+	};
 
-		{"net_iface", 			"#* Starts with the Network Interface specified here."},
+	//* One published version of live, <applied> is the seq of the last change_batch from the runner included
+	struct version {
+		values data;
+		uint64_t number, applied;
+	};
 
-		{"show_battery", 		"#* Show battery stats in top right if battery is present."},
+	//? Latest published version and the version the runner thread is copying, older versions are freed by publish()
+	atomic<version*> published (nullptr);
+	atomic<version*> reading (nullptr);
 
-		{"log_level", 			"#* Set loglevel for \"~/.config/btop/btop.log\" levels are: \"ERROR\" \"WARNING\" \"INFO\" \"DEBUG\".\n"
-								"#* The level set includes all lower levels, i.e. \"DEBUG\" will show all logging info."},
+	//? Changes handed from the runner thread to the main thread, swapped in and out with exchange()
+	atomic<change_batch*> returned (nullptr);
 
-		{"enable_websocket",	"#* Enable WebSocket server for Resonite integration. Allows remote viewing of btop interface."},
+	//? Main thread state
+	vector<std::unique_ptr<version>> versions;
+	uint64_t version_number = 0, applied = 0;
+	bool changed = true;
 
-		{"websocket_port",		"#* Port for WebSocket server to listen on. Default is 8080."}
-	};
+	//? Runner thread state, changes not yet reported and batches reported but not yet included in a published version
+	uint64_t snapshot_number = 0, runner_seq = 0;
+	vector<change> unreported;
+	std::deque<change_batch> unapplied;
 
-	unordered_flat_map<string, string> strings = {
-		{"color_theme", "Default"},
-		{"shown_boxes", "cpu mem net proc"},
-		{"graph_symbol", "tty"},
-		{"presets", "cpu:1:default,proc:0:default cpu:0:default,mem:0:default,net:0:default cpu:0:block,net:0:tty"},
-		{"graph_symbol_cpu", "default"},
-		{"graph_symbol_mem", "default"},
-		{"graph_symbol_net", "default"},
-		{"graph_symbol_proc", "default"},
-		{"proc_sorting", "cpu lazy"},
-		{"services_sorting", "cpu lazy"},
-		{"cpu_graph_upper", "total"},
-		{"cpu_graph_lower", "gpu"},
-		{"selected_gpu", "Auto"},
-		{"temp_scale", "celsius"},
-		{"clock_format", "%X"},
-		{"custom_cpu_name", ""},
-		{"disks_filter", ""},
-		{"io_graph_speeds", ""},
-		{"net_iface", ""},
-		{"log_level", "WARNING"},
-		{"proc_filter", ""},
-		{"proc_command", ""},
-		{"selected_name", ""},
-		{"selected_status", ""},
-		{"detailed_name", ""}
-	};
-	unordered_flat_map<string, string> stringsTmp;
-
-	unordered_flat_map<string, bool> bools = {
-		{"theme_background", true},
-		{"truecolor", true},
-		{"rounded_corners", false},
-		{"proc_services", false},
-		{"proc_reversed", false},
-		{"proc_tree", false},
-		{"proc_colors", true},
-		{"proc_gradient", true},
-		{"proc_per_core", false},
-		{"proc_mem_bytes", true},
-		{"proc_left", false},
-		{"cpu_invert_lower", true},
-		{"cpu_single_graph", false},
-		{"cpu_bottom", false},
-		{"show_uptime", true},
-		{"check_temp", true},
-		{"enable_ohmr", true},
-		{"show_gpu", true},
-		{"show_coretemp", true},
-		{"background_update", true},
-		{"mem_graphs", true},
-		{"mem_below_net", false},
-		{"show_page", true},
-		{"show_disks", true},
-		{"only_physical", true},
-		{"show_io_stat", true},
-		{"io_mode", false},
-		{"base_10_sizes", false},
-		{"io_graph_combined", false},
-		{"net_auto", true},
-		{"net_sync", false},
-		{"show_battery", true},
-		{"enable_websocket", false},
-		{"vim_keys", false},
-		{"tty_mode", false},
-		{"disk_free_priv", false},
-		{"force_tty", false},
-		{"lowcolor", false},
-		{"show_detailed", false},
-		{"proc_filtering", false},
-	};
-	unordered_flat_map<string, bool> boolsTmp;
-
-	unordered_flat_map<string, int> ints = {
-		{"update_ms", 1500},
-		{"net_download", 100},
-		{"net_upload", 100},
-		{"detailed_pid", 0},
-		{"selected_pid", 0},
-		{"selected_depth", 0},
-		{"proc_start", 0},
-		{"proc_selected", 0},
-		{"proc_last_selected", 0},
-		{"gpu_mem_override", 0},
-		{"websocket_port", 8080}
-	};
-	unordered_flat_map<string, int> intsTmp;
+	void _apply(values& target, const change& c) {
+		if (c.type == Tbool) target.bools[c.index] = (c.number != 0);
+		else if (c.type == Tint) target.ints[c.index] = c.number;
+		else target.strings[c.index] = c.text;
+	}
 
-	bool _locked(const string& name) {
-		atomic_wait(writelock, true);
-		if (not write_new and rng::find_if(descriptions, [&name](const auto& a) { return a.at(0) == name; }) != descriptions.end())
+	//? Mark <type> key <index> as changed by the calling thread
+	void _changed(const Types type, const uint16_t index) {
+		if (rng::find_if(entries, [&](const entry& e) { return e.type == type and e.index == index; })->description != nullptr)
 			write_new = true;
-		return locked.load();
+		if (current != &snapshot) {
+			changed = true;
+			return;
+		}
+		if (type == Tbool) unreported.push_back({type, index, snapshot.bools[index], ""});
+		else if (type == Tint) unreported.push_back({type, index, snapshot.ints[index], ""});
+		else unreported.push_back({type, index, 0, snapshot.strings[index]});
 	}
 
 	fs::path conf_dir;
@@ -353,11 +196,6 @@ namespace Config {
 		if (check_boxes(boxes)) set("shown_boxes", boxes);
 	}
 
-	void lock() {
-		atomic_wait(writelock);
-		locked = true;
-	}
-
 	string validError;
 
 	bool intValid(const string& name, const string& value) {
@@ -384,12 +222,27 @@ namespace Config {
 		else if (name == "update_ms" and i_value > 86400000)
 			validError = "Config value update_ms set too high (>86400000).";
 
+		else if (name == "adaptive_max_ms" and i_value < 100)
+			validError = "Config value adaptive_max_ms set too low (<100).";
+
+		else if (name == "adaptive_max_ms" and i_value > 86400000)
+			validError = "Config value adaptive_max_ms set too high (>86400000).";
+
+		else if (name == "adaptive_threshold" and (i_value < 1 or i_value > 100))
+			validError = "Config value adaptive_threshold must be between 1 and 100.";
+
 		else if (name == "websocket_port" and i_value < 1024)
 			validError = "Config value websocket_port set too low (<1024).";
 
 		else if (name == "websocket_port" and i_value > 65535)
 			validError = "Config value websocket_port set too high (>65535).";
 
+		else if (is_in(name, "headless_width", "headless_height") and i_value < 1)
+			validError = "Config value " + name + " set too low (<1).";
+
+		else if (is_in(name, "headless_width", "headless_height") and i_value > 10000)
+			validError = "Config value " + name + " set too high (>10000).";
+
 		else
 			return true;
 
@@ -443,58 +296,93 @@ namespace Config {
 	}
 
 	string getAsString(const string& name) {
-		if (bools.contains(name))
-			return (bools.at(name) ? "True" : "False");
-		else if (ints.contains(name))
-			return to_string(ints.at(name));
-		else if (strings.contains(name))
-			return strings.at(name);
+		if (bool_key::contains(name))
+			return (getB(name) ? "True" : "False");
+		else if (int_key::contains(name))
+			return to_string(getI(name));
+		else if (string_key::contains(name))
+			return getS(name);
 		return "";
 	}
 
-	void flip(const string& name) {
-		if (_locked(name)) {
-			if (boolsTmp.contains(name)) boolsTmp.at(name) = not boolsTmp.at(name);
-			else boolsTmp.insert_or_assign(name, (not bools.at(name)));
-		}
-		else bools.at(name) = not bools.at(name);
+	void set(const bool_key key, const bool value) {
+		current->bools[key.index] = value;
+		_changed(Tbool, key.index);
 	}
 
-	void unlock() {
-		if (not locked) return;
-		atomic_wait(Runner::active);
-		atomic_lock lck(writelock, true);
-		try {
-			if (Proc::shown) {
-				ints.at("selected_pid") = Proc::selected_pid;
-				strings.at("selected_name") = Proc::selected_name;
-				strings.at("selected_status") = Proc::selected_status;
-				ints.at("proc_start") = Proc::start;
-				ints.at("proc_selected") = Proc::selected;
-				ints.at("selected_depth") = Proc::selected_depth;
-			}
+	void set(const int_key key, const int value) {
+		current->ints[key.index] = value;
+		_changed(Tint, key.index);
+	}
 
-			for (auto& item : stringsTmp) {
-				strings.at(item.first) = item.second;
-			}
-			stringsTmp.clear();
+	void set(const string_key key, const string& value) {
+		current->strings[key.index] = value;
+		_changed(Tstring, key.index);
+	}
 
-			for (auto& item : intsTmp) {
-				ints.at(item.first) = item.second;
-			}
-			intsTmp.clear();
+	void flip(const bool_key key) {
+		set(key, not getB(key));
+	}
+
+	void publish() {
+		if (std::unique_ptr<change_batch> batch{returned.exchange(nullptr)}) {
+			for (const auto& c : batch->changes) _apply(live, c);
+			applied = batch->seq;
+			changed = true;
+		}
+		if (not changed) return;
+		changed = false;
+
+		versions.push_back(std::make_unique<version>(version{live, ++version_number, applied}));
+		const version* latest = versions.back().get();
+		published.store(versions.back().get());
+
+		//? Free versions that are neither the latest nor being copied by the runner thread
+		const version* in_use = reading.load();
+		std::erase_if(versions, [&](const auto& v) { return v.get() != latest and v.get() != in_use; });
+	}
 
-			for (auto& item : boolsTmp) {
-				bools.at(item.first) = item.second;
+	void acquire() {
+		version* latest;
+		do {
+			latest = published.load();
+			reading.store(latest);
+		} while (published.load() != latest);
+
+		if (latest != nullptr and latest->number != snapshot_number) {
+			snapshot = latest->data;
+			snapshot_number = latest->number;
+
+			//? Keep values changed by this thread that the main thread hasn't included yet
+			while (not unapplied.empty() and unapplied.front().seq <= latest->applied) unapplied.pop_front();
+			for (const auto& batch : unapplied) {
+				for (const auto& c : batch.changes) _apply(snapshot, c);
 			}
-			boolsTmp.clear();
 		}
-		catch (const std::exception& e) {
-			Global::exit_error_msg = "Exception during Config::unlock() : " + (string)e.what();
-			clean_quit(1);
+		reading.store(nullptr);
+	}
+
+	void report() {
+		if (Proc::shown) {
+			const array<int, 4> proc_ints = {Proc::selected_pid, Proc::start, Proc::selected, Proc::selected_depth};
+			const array<Ints, 4> proc_keys = {selected_pid, proc_start, proc_selected, selected_depth};
+			for (size_t i = 0; i < proc_keys.size(); i++) {
+				if (snapshot.ints[proc_keys[i]] != proc_ints[i]) set(proc_keys[i], proc_ints[i]);
+			}
+			if (snapshot.strings[selected_name] != Proc::selected_name) set(selected_name, Proc::selected_name);
+			if (snapshot.strings[selected_status] != Proc::selected_status) set(selected_status, Proc::selected_status);
 		}
+		if (unreported.empty()) return;
+
+		unapplied.push_back({++runner_seq, std::move(unreported)});
+		unreported.clear();
 
-		locked = false;
+		//? Merge with a batch the main thread hasn't taken yet
+		change_batch* batch = returned.exchange(nullptr);
+		if (batch == nullptr) batch = new change_batch{};
+		batch->seq = runner_seq;
+		batch->changes.insert(batch->changes.end(), unapplied.back().changes.begin(), unapplied.back().changes.end());
+		returned.store(batch);
 	}
 
 	bool check_boxes(const string& boxes) {
@@ -539,9 +427,6 @@ namespace Config {
 		}
 		std::ifstream cread(conf_file);
 		if (cread.good()) {
-			vector<string> valid_names;
-			for (auto &n : descriptions)
-				valid_names.push_back(n[0]);
 			if (string v_string; cread.peek() != '#' or (getline(cread, v_string, '\n') and not s_contains(v_string, Global::Version)))
 				write_new = true;
 			while (not cread.eof()) {
@@ -553,20 +438,21 @@ namespace Config {
 				string name, value;
 				getline(cread, name, '=');
 				if (name.ends_with(' ')) name = trim(name);
-				if (not v_contains(valid_names, name)) {
+				const auto key = rng::find_if(entries, [&name](const entry& e) { return e.description != nullptr and e.name == name; });
+				if (key == entries.end()) {
 					cread.ignore(SSmax, '\n');
 					continue;
 				}
 				cread >> std::ws;
 
-				if (bools.contains(name)) {
+				if (key->type == Tbool) {
 					cread >> value;
 					if (not isbool(value))
 						load_warnings.push_back("Got an invalid bool value for config name: " + name);
 					else
-						bools.at(name) = stobool(value);
+						live.bools[key->index] = stobool(value);
 				}
-				else if (ints.contains(name)) {
+				else if (key->type == Tint) {
 					cread >> value;
 					if (not isint(value))
 						load_warnings.push_back("Got an invalid integer value for config name: " + name);
@@ -574,9 +460,9 @@ namespace Config {
 						load_warnings.push_back(validError);
 					}
 					else
-						ints.at(name) = stoi(value);
+						live.ints[key->index] = stoi(value);
 				}
-				else if (strings.contains(name)) {
+				else {
 					if (cread.peek() == '"') {
 						cread.ignore(1);
 						getline(cread, value, '"');
@@ -586,7 +472,7 @@ namespace Config {
 					if (not stringValid(name, value))
 						load_warnings.push_back(validError);
 					else
-						strings.at(name) = value;
+						live.strings[key->index] = value;
 				}
 
 				cread.ignore(SSmax, '\n');
@@ -602,15 +488,16 @@ namespace Config {
 		std::ofstream cwrite(conf_file, std::ios::trunc);
 		if (cwrite.good()) {
 			cwrite << "#? Config file for btop4win v. " << Global::Version;
-			for (auto [name, description] : descriptions) {
-				cwrite 	<< "\n\n" << (description.empty() ? "" : description + "\n")
+			for (const auto& [type, index, name, description] : entries) {
+				if (description == nullptr) continue;
+				cwrite 	<< "\n\n" << description << (*description == '\0' ? "" : "\n")
 						<< name << " = ";
-				if (strings.contains(name))
-					cwrite << "\"" << strings.at(name) << "\"";
-				else if (ints.contains(name))
-					cwrite << ints.at(name);
-				else if (bools.contains(name))
-					cwrite << (bools.at(name) ? "True" : "False");
+				if (type == Tstring)
+					cwrite << "\"" << live.strings[index] << "\"";
+				else if (type == Tint)
+					cwrite << live.ints[index];
+				else
+					cwrite << (live.bools[index] ? "True" : "False");
 			}
 		}
 	}
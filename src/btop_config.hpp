@@ -19,24 +19,196 @@ tab-size = 4
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
 #include <robin_hood.h>
 #include <filesystem>
 
 using std::string, std::vector, robin_hood::unordered_flat_map;
 
+//? Every config key in config file order with its default value and description, keys are passed to B, I or S by type
+//? Keys with a null description hold runtime state that isn't read from or written to the config file
+#define BTOP_CONFIG_KEYS(B, I, S) \
+	S(color_theme, "Default", \
+		"#* Name of a btop++/bpytop/bashtop formatted \".theme\" file, \"Default\" and \"TTY\" for builtin themes.\n" \
+		"#* Themes should be placed in \"themes\" folder in same folder as btop4win.exe") \
+	B(theme_background, true, "#* If the theme set background should be shown, set to False if you want terminal background transparency.") \
+	B(truecolor, true, "#* Sets if 24-bit truecolor should be used, will convert 24-bit colors to 256 color (6x6x6 color cube) if false.") \
+	B(force_tty, false, \
+		"#* Set to true to force tty mode regardless if a real tty has been detected or not.\n" \
+		"#* Will force 16-color mode and TTY theme, set all graph symbols to \"tty\" and swap out other non tty friendly symbols.") \
+	S(presets, "cpu:1:default,proc:0:default cpu:0:default,mem:0:default,net:0:default cpu:0:block,net:0:tty", \
+		"#* Define presets for the layout of the boxes. Preset 0 is always all boxes shown with default settings. Max 9 presets.\n" \
+		"#* Format: \"box_name:P:G,box_name:P:G\" P=(0 or 1) for alternate positions, G=graph symbol to use for box.\n" \
+		"#* Use withespace \" \" as separator between different presets.\n" \
+		"#* Example: \"cpu:0:default,mem:0:tty,proc:1:default cpu:0:braille,proc:0:tty\"") \
+	B(vim_keys, false, \
+		"#* Set to True to enable \"h,j,k,l,g,G\" keys for directional control in lists.\n" \
+		"#* Conflicting keys for h:\"help\" and k:\"kill\" is accessible while holding shift.") \
+	B(enable_ohmr, true, \
+		"#* Enables monitoring of CPU temps, accurate CPU clock and GPU via Libre Hardware Monitor.\n" \
+		"#* Needs the my DLL's from (https://github.com/aristocratos/LHM-CppExport) installed in same folder as btop4win.exe.") \
+	B(show_gpu, true, "#* Also show gpu stats in cpu and mem box. Needs Libre Hardware Monitor Report enabled.") \
+	S(selected_gpu, "Auto", "#* Which GPU to display if multiple is detected.") \
+	I(gpu_mem_override, 0, "#* Manually set and override the GPU total memory shown when not correctly detected. Value in MiB. Example: \"gpu_mem_override = 1024\" for 1 GiB.") \
+	B(rounded_corners, false, "#* Rounded corners on boxes, is ignored if TTY mode is ON.") \
+	S(graph_symbol, "tty", \
+		"#* Default symbols to use for graph creation, \"braille\", \"block\" or \"tty\".\n" \
+		"#* \"braille\" offers the highest resolution but might not be included in all fonts.\n" \
+		"#* \"block\" has half the resolution of braille but uses more common characters.\n" \
+		"#* \"tty\" uses only 3 different symbols but will work with most fonts and should work in a real TTY.\n" \
+		"#* Note that \"tty\" only has half the horizontal resolution of the other two, so will show a shorter historical view.") \
+	S(graph_symbol_cpu, "default", "# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\".") \
+	S(graph_symbol_mem, "default", "# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\".") \
+	S(graph_symbol_net, "default", "# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\".") \
+	S(graph_symbol_proc, "default", "# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\".") \
+	S(shown_boxes, "cpu mem net proc", "#* Manually set which boxes to show. Available values are \"cpu mem net proc\", separate values with whitespace.") \
+	I(update_ms, 1500, "#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs.") \
+	B(adaptive_update, false, \
+		"#* Stretch the update time while cpu and memory usage is stable, no keys are pressed and no websocket client is connected.\n" \
+		"#* Snaps back to update_ms on input, a new websocket client or a usage change larger than adaptive_threshold.") \
+	I(adaptive_max_ms, 10000, "#* Longest update time in milliseconds that adaptive_update is allowed to stretch to.") \
+	I(adaptive_threshold, 5, "#* Change in cpu or memory usage in percent between two updates that counts as activity for adaptive_update.") \
+	S(proc_sorting, "cpu lazy", \
+		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n" \
+		"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly.") \
+	B(proc_services, false, "#* Show services in the process box instead of processes.") \
+	S(services_sorting, "cpu lazy", \
+		"#* Services sorting, \"service\" \"caption\" \"status\" \"memory\" \"cpu lazy\" \"cpu direct\",\n" \
+		"#* \"cpu lazy\" sorts top service over time (easier to follow), \"cpu direct\" updates top service directly.") \
+	B(proc_reversed, false, "#* Reverse sorting order, True or False.") \
+	B(proc_tree, false, "#* Show processes as a tree.") \
+	B(proc_colors, true, "#* Use the cpu graph colors in the process list.") \
+	B(proc_gradient, true, "#* Use a darkening gradient in the process list.") \
+	B(proc_per_core, false, "#* If process cpu usage should be of the core it's running on or usage of the total available cpu power.") \
+	B(proc_mem_bytes, true, "#* Show process memory as bytes instead of percent.") \
+	B(proc_left, false, "#* Show proc box on left side of screen instead of right.") \
+	S(cpu_graph_upper, "total", \
+		"#* Sets the CPU stat shown in upper half of the CPU graph, \"total\" is always available.\n" \
+		"#* Select from a list of detected attributes from the options menu.") \
+	S(cpu_graph_lower, "gpu", \
+		"#* Sets the CPU stat shown in lower half of the CPU graph, \"total\" is always available.\n" \
+		"#* Select from a list of detected attributes from the options menu.") \
+	B(cpu_invert_lower, true, "#* Toggles if the lower CPU graph should be inverted.") \
+	B(cpu_single_graph, false, "#* Set to True to completely disable the lower CPU graph.") \
+	B(cpu_bottom, false, "#* Show cpu box at bottom of screen instead of top.") \
+	B(show_uptime, true, "#* Shows the system uptime in the CPU box.") \
+	B(check_temp, true, "#* Show cpu temperature.") \
+	S(cpu_sensor, "Auto", "#* Which sensor to use for cpu temperature, use options menu to select from list of available sensors.") \
+	B(show_coretemp, true, "#* Show temperatures for cpu cores also if check_temp is True and sensors has been found.") \
+	S(temp_scale, "celsius", "#* Which temperature scale to use, available values: \"celsius\", \"fahrenheit\", \"kelvin\" and \"rankine\".") \
+	B(base_10_sizes, false, "#* Use base 10 for bits/bytes sizes, KB = 1000 instead of KiB = 1024.") \
+	S(clock_format, "%X", \
+		"#* Draw a clock at top of screen, formatting according to strftime, empty string to disable.\n" \
+		"#* Special formatting: /host = hostname | /user = username | /uptime = system uptime") \
+	B(background_update, true, "#* Update main ui in background when menus are showing, set this to false if the menus is flickering too much for comfort.") \
+	S(custom_cpu_name, "", "#* Custom cpu model name, empty string to disable.") \
+	S(disks_filter, "", \
+		"#* Optional filter for shown disks, should be full path of a mountpoint, separate multiple values with whitespace \" \".\n" \
+		"#* Begin line with \"exclude=\" to change to exclude filter, otherwise defaults to \"most include\" filter. Example: disks_filter=\"exclude=D:\\ E:\\\".") \
+	B(mem_graphs, true, "#* Show graphs instead of meters for memory values.") \
+	B(mem_below_net, false, "#* Show mem box below net box instead of above.") \
+	B(show_page, true, "#* If page memory should be shown in memory box.") \
+	B(show_disks, true, "#* If mem box should be split to also show disks info.") \
+	B(only_physical, true, "#* Filter out non physical disks. Set this to False to include network disks, RAM disks and similar.") \
+	B(disk_free_priv, false, "#* Set to true to show available disk space for privileged users.") \
+	B(show_io_stat, true, "#* Toggles if io activity % (disk busy time) should be shown in regular disk usage view.") \
+	B(io_mode, false, "#* Toggles io mode for disks, showing big graphs for disk read/write speeds.") \
+	B(io_graph_combined, false, "#* Set to True to show combined read/write io graphs in io mode.") \
+	S(io_graph_speeds, "", \
+		"#* Set the top speed for the io graphs in MiB/s (100 by default), use format \"device:\\speed\" separate disks with whitespace \" \".\n" \
+		"#* Example: \"C:\\100 D:\\20 G:\\1\".") \
+	I(net_download, 100, "#* Set fixed values for network graphs in Mebibits. Is only used if net_auto is also set to False.") \
+	I(net_upload, 100, "") \
+	B(net_auto, true, "#* Use network graphs auto rescaling mode, ignores any values set above and rescales down to 10 Kibibytes at the lowest.") \
+	B(net_sync, false, "#* Sync the auto scaling for download and upload to whichever currently has the highest scale.") \
+	S(net_iface, "", "#* Starts with the Network Interface specified here.") \
+	B(show_battery, true, "#* Show battery stats in top right if battery is present.") \
+	S(log_level, "WARNING", \
+		"#* Set loglevel for \"~/.config/btop/btop.log\" levels are: \"ERROR\" \"WARNING\" \"INFO\" \"DEBUG\".\n" \
+		"#* The level set includes all lower levels, i.e. \"DEBUG\" will show all logging info.") \
+	B(enable_websocket, false, "#* Enable WebSocket server for Resonite integration. Allows remote viewing of btop interface.") \
+	I(websocket_port, 8080, "#* Port for WebSocket server to listen on. Default is 8080.") \
+	I(headless_width, 160, "#* Width in columns of the virtual terminal used when started with --headless.") \
+	I(headless_height, 50, "#* Height in lines of the virtual terminal used when started with --headless.") \
+	S(proc_filter, "", nullptr) \
+	S(proc_command, "", nullptr) \
+	S(selected_name, "", nullptr) \
+	S(selected_status, "", nullptr) \
+	S(detailed_name, "", nullptr) \
+	B(tty_mode, false, nullptr) \
+	B(lowcolor, false, nullptr) \
+	B(show_detailed, false, nullptr) \
+	B(proc_filtering, false, nullptr) \
+	I(detailed_pid, 0, nullptr) \
+	I(selected_pid, 0, nullptr) \
+	I(selected_depth, 0, nullptr) \
+	I(proc_start, 0, nullptr) \
+	I(proc_selected, 0, nullptr) \
+	I(proc_last_selected, 0, nullptr)
+
 //* Functions and variables for reading and writing the btop config file
 namespace Config {
 
 	extern std::filesystem::path conf_dir;
 	extern std::filesystem::path conf_file;
 
-	extern unordered_flat_map<string, string> strings;
-	extern unordered_flat_map<string, string> stringsTmp;
-	extern unordered_flat_map<string, bool> bools;
-	extern unordered_flat_map<string, bool> boolsTmp;
-	extern unordered_flat_map<string, int> ints;
-	extern unordered_flat_map<string, int> intsTmp;
+	#define CONFIG_KEY(name, ...) name,
+	#define CONFIG_NAME(name, ...) #name,
+	#define CONFIG_SKIP(...)
+
+	enum Bools : uint16_t { BTOP_CONFIG_KEYS(CONFIG_KEY, CONFIG_SKIP, CONFIG_SKIP) Bcount };
+	enum Ints : uint16_t { BTOP_CONFIG_KEYS(CONFIG_SKIP, CONFIG_KEY, CONFIG_SKIP) Icount };
+	enum Strings : uint16_t { BTOP_CONFIG_KEYS(CONFIG_SKIP, CONFIG_SKIP, CONFIG_KEY) Scount };
+
+	inline constexpr std::array<std::string_view, Bcount> bool_names = { BTOP_CONFIG_KEYS(CONFIG_NAME, CONFIG_SKIP, CONFIG_SKIP) };
+	inline constexpr std::array<std::string_view, Icount> int_names = { BTOP_CONFIG_KEYS(CONFIG_SKIP, CONFIG_NAME, CONFIG_SKIP) };
+	inline constexpr std::array<std::string_view, Scount> string_names = { BTOP_CONFIG_KEYS(CONFIG_SKIP, CONFIG_SKIP, CONFIG_NAME) };
+
+	#undef CONFIG_KEY
+	#undef CONFIG_NAME
+	#undef CONFIG_SKIP
+
+	template<size_t N>
+	constexpr size_t name_pos(const std::array<std::string_view, N>& names, std::string_view name) {
+		for (size_t i = 0; i < N; i++) if (names[i] == name) return i;
+		return N;
+	}
+
+	//* Key of one type, string literals are resolved at compile time so a misspelled name or wrong type fails to compile
+	//* Other strings are looked up at runtime and throw std::out_of_range for unknown names
+	template<typename Index, const auto& names>
+	struct config_key {
+		Index index;
+		constexpr config_key(const Index index) : index(index) {}
+		consteval config_key(const char* name) : index((Index)name_pos(names, name)) {
+			if (index == names.size()) throw "Unknown config key";
+		}
+		config_key(const string& name) : index((Index)name_pos(names, name)) {
+			if (index == names.size()) throw std::out_of_range("Config::config_key() -> Unknown key: " + name);
+		}
+		static bool contains(const string& name) { return name_pos(names, name) < names.size(); }
+	};
+
+	using bool_key = config_key<Bools, bool_names>;
+	using int_key = config_key<Ints, int_names>;
+	using string_key = config_key<Strings, string_names>;
+
+	//* One complete set of config values
+	struct values {
+		std::array<bool, Bcount> bools;
+		std::array<int, Icount> ints;
+		std::array<string, Scount> strings;
+	};
+
+	//? Values edited by the main thread and the runner thread's copy of the latest version published from them
+	extern values live, snapshot;
+
+	//? Values read by this thread, points to snapshot for the runner thread and to live for all others
+	extern thread_local values* current;
 
 	const vector<string> valid_graph_symbols = { "braille", "block", "tty" };
 	const vector<string> valid_graph_symbols_def = { "default", "braille", "block", "tty" };
@@ -60,16 +232,14 @@ namespace Config {
 	//* Apply selected preset
 	void apply_preset(const string& preset);
 
-	bool _locked(const string& name);
-
-	//* Return bool for config key <name>
-	inline const bool& getB(const string& name) { return bools.at(name); }
+	//* Return bool for config key <key>
+	inline const bool& getB(const bool_key key) { return current->bools[key.index]; }
 
-	//* Return integer for config key <name>
-	inline const int& getI(const string& name) { return ints.at(name); }
+	//* Return integer for config key <key>
+	inline const int& getI(const int_key key) { return current->ints[key.index]; }
 
-	//* Return string for config key <name>
-	inline const string& getS(const string& name) { return strings.at(name); }
+	//* Return string for config key <key>
+	inline const string& getS(const string_key key) { return current->strings[key.index]; }
 
 	string getAsString(const string& name);
 
@@ -78,32 +248,26 @@ namespace Config {
 	bool intValid(const string& name, const string& value);
 	bool stringValid(const string& name, const string& value);
 
-	//* Set config key <name> to bool <value>
-	inline void set(const string& name, const bool& value) {
-		if (_locked(name)) boolsTmp.insert_or_assign(name, value);
-		else bools.at(name) = value;
-	}
+	//* Set config key <key> to bool <value>
+	void set(const bool_key key, const bool value);
 
-	//* Set config key <name> to int <value>
-	inline void set(const string& name, const int& value) {
-		if (_locked(name)) intsTmp.insert_or_assign(name, value);
-		else ints.at(name) = value;
-	}
+	//* Set config key <key> to int <value>
+	void set(const int_key key, const int value);
 
-	//* Set config key <name> to string <value>
-	inline void set(const string& name, const string& value) {
-		if (_locked(name)) stringsTmp.insert_or_assign(name, value);
-		else strings.at(name) = value;
-	}
+	//* Set config key <key> to string <value>
+	void set(const string_key key, const string& value);
+
+	//* Flip config key bool <key>
+	void flip(const bool_key key);
 
-	//* Flip config key bool <name>
-	void flip(const string& name);
+	//* Publish a new version of live values if changed and take in values changed by the runner thread, never waits for the runner
+	void publish();
 
-	//* Lock config and cache changes until unlocked
-	void lock();
+	//* Update snapshot from the latest published version, called by the runner thread at the start of every cycle
+	void acquire();
 
-	//* Unlock config and write any cached values to config
-	void unlock();
+	//* Hand values changed during the cycle back to the main thread, called by the runner thread at the end of every cycle
+	void report();
 
 	//* Load the config file from disk
 	void load(const std::filesystem::path& conf_file, vector<string>& load_warnings);
@@ -111,10 +275,3 @@ namespace Config {
 	//* Write the config file to disk
 	void write();
 }
-
-
-
-
-
-
-
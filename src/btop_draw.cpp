@@ -222,46 +222,57 @@ namespace Draw {
 
 	string createBox(const int x, const int y, const int width, const int height, string line_color, const bool fill, const string title, const string title2, const int num) {
 		string out;
+		out.reserve((fill ? width * height : 2 * width + 2 * height) * 3 + 64);
+		Esc::writer w(out);
 		if (line_color.empty()) line_color = Theme::c("div_line");
 		const auto& tty_mode = Config::getB("tty_mode");
 		const auto& rounded = Config::getB("rounded_corners");
-		const string numbering = (num == 0) ? "" : Theme::c("hi_fg") + (tty_mode ? std::to_string(num) : Symbols::superscript.at(clamp(num, 0, 9)));
 		const auto& right_up = (tty_mode or not rounded ? Symbols::right_up : Symbols::round_right_up);
 		const auto& left_up = (tty_mode or not rounded ? Symbols::left_up : Symbols::round_left_up);
 		const auto& right_down = (tty_mode or not rounded ? Symbols::right_down : Symbols::round_right_down);
 		const auto& left_down = (tty_mode or not rounded ? Symbols::left_down : Symbols::round_left_down);
+		auto numbering = [&] {
+			if (num == 0) return;
+			w << Theme::c("hi_fg");
+			if (tty_mode) w << num;
+			else w << Symbols::superscript.at(clamp(num, 0, 9));
+		};
 
-		out = Fx::reset + line_color;
+		w << Fx::reset << line_color;
 
 		//? Draw horizontal lines
 		for (const int& hpos : {y, y + height - 1}) {
-			out += Mv::to(hpos, x) + Symbols::h_line * (width - 1);
+			w << Esc::to(hpos, x) << Esc::repeat(Symbols::h_line, width - 1);
 		}
 
 		//? Draw vertical lines and fill if enabled
 		for (const int& hpos : iota(y + 1, y + height - 1)) {
-			out += Mv::to(hpos, x) + Symbols::v_line
-				+  ((fill) ? string(width - 2, ' ') : Mv::r(width - 2))
-				+  Symbols::v_line;
+			w << Esc::to(hpos, x) << Symbols::v_line;
+			if (fill) w << Esc::repeat(" ", width - 2);
+			else w << Esc::r(width - 2);
+			w << Symbols::v_line;
 		}
 
 		//? Draw corners
-		out += 	Mv::to(y, x) + left_up
-			+	Mv::to(y, x + width - 1) + right_up
-			+	Mv::to(y + height - 1, x) +left_down
-			+	Mv::to(y + height - 1, x + width - 1) + right_down;
+		w	<< Esc::to(y, x) << left_up
+			<< Esc::to(y, x + width - 1) << right_up
+			<< Esc::to(y + height - 1, x) << left_down
+			<< Esc::to(y + height - 1, x + width - 1) << right_down;
 
 		//? Draw titles if defined
 		if (not title.empty()) {
-			out += Mv::to(y, x + 2) + Symbols::title_left + Fx::b + numbering + Theme::c("title") + title
-				+  Fx::ub + line_color + Symbols::title_right;
+			w << Esc::to(y, x + 2) << Symbols::title_left << Fx::b;
+			numbering();
+			w << Theme::c("title") << title << Fx::ub << line_color << Symbols::title_right;
 		}
 		if (not title2.empty()) {
-			out += Mv::to(y + height - 1, x + 2) + Symbols::title_left_down + Fx::b + numbering + Theme::c("title") + title2
-				+  Fx::ub + line_color + Symbols::title_right_down;
+			w << Esc::to(y + height - 1, x + 2) << Symbols::title_left_down << Fx::b;
+			numbering();
+			w << Theme::c("title") << title2 << Fx::ub << line_color << Symbols::title_right_down;
 		}
 
-		return out + Fx::reset + Mv::to(y + 1, x + 1);
+		w << Fx::reset << Esc::to(y + 1, x + 1);
+		return out;
 	}
 
 	bool update_clock(bool force) {
@@ -278,15 +289,17 @@ namespace Draw {
 		};
 		static uint64_t c_time = 0;
 		static size_t clock_len = 0;
-		static string clock_str;
+		static string clock_raw, clock_str;
 
+		//? Time is formatted at most once per second, the clock is only rebuilt if the formatted time changed or uptime is shown
 		if (auto n_time = time_ms() / 1000; not force and n_time == c_time)
 			return false;
 		else {
 			c_time = n_time;
-			const auto new_clock = Tools::strf_time(clock_format);
-			if (not force and new_clock == clock_str) return false;
-			clock_str = new_clock;
+			auto new_clock = Tools::strf_time(clock_format);
+			if (not force and new_clock == clock_raw and not s_contains(clock_format, "/uptime")) return false;
+			clock_raw = std::move(new_clock);
+			clock_str = clock_raw;
 		}
 
 		auto& out = Global::clock;
@@ -314,15 +327,16 @@ namespace Draw {
 
 		clock_str = uresize(clock_str, std::max(10, width - 66 - (Term::width >= 100 and Config::getB("show_battery") and Cpu::has_battery ? 22 : 0)));
 		out.clear();
+		Esc::writer w(out);
 
 		if (clock_str.size() != clock_len) {
 			if (not Global::resized and clock_len > 0)
-				out = Mv::to(y, x+(width / 2)-(clock_len / 2)) + Fx::ub + Theme::c("cpu_box") + Symbols::h_line * clock_len;
+				w << Esc::to(y, x+(width / 2)-(clock_len / 2)) << Fx::ub << Theme::c("cpu_box") << Esc::repeat(Symbols::h_line, clock_len);
 			clock_len = clock_str.size();
 		}
 
-		out += Mv::to(y, x+(width / 2)-(clock_len / 2)) + Fx::ub + Theme::c("cpu_box") + title_left
-			+ Theme::c("title") + Fx::b + clock_str + Theme::c("cpu_box") + Fx::ub + title_right;
+		w << Esc::to(y, x+(width / 2)-(clock_len / 2)) << Fx::ub << Theme::c("cpu_box") << title_left
+			<< Theme::c("title") << Fx::b << clock_str << Theme::c("cpu_box") << Fx::ub << title_right;
 
 		return true;
 	}
@@ -330,40 +344,39 @@ namespace Draw {
 	//* Meter class ------------------------------------------------------------------------------------------------------------>
 	Meter::Meter() {}
 
-	Meter::Meter(const int width, const string& color_gradient, const bool invert) : width(width), color_gradient(color_gradient), invert(invert) {}
+	Meter::Meter(const int width, const string& color_gradient, const bool invert) : width(width), gradient(&Theme::g(color_gradient)), invert(invert) {}
 
-	string Meter::operator()(int value) {
-		if (width < 1) return "";
+	const string& Meter::operator()(int value) {
+		static const string empty;
+		if (width < 1) return empty;
 		value = clamp(value, 0, 100);
-		if (not cache.at(value).empty()) return cache.at(value);
 		auto& out = cache.at(value);
+		if (not out.empty()) return out;
+		Esc::writer w(out);
 		for (const int& i : iota(1, width + 1)) {
 			int y = round((double)i * 100.0 / width);
 			if (value >= y)
-				out += Theme::g(color_gradient).at(invert ? 100 - y : y) + Symbols::meter;
+				w << gradient->at(invert ? 100 - y : y) << Symbols::meter;
 			else {
-				out += Theme::c("meter_bg") + Symbols::meter * (width + 1 - i);
+				w << Theme::c("meter_bg") << Esc::repeat(Symbols::meter, width + 1 - i);
 				break;
 			}
 		}
-		out += Fx::reset;
+		w << Fx::reset;
 		return out;
 	}
 
 	//* Graph class ------------------------------------------------------------------------------------------------------------>
-	void Graph::_create(const deque<long long>& data, int data_offset) {
+	void Graph::_create(span<const long long> data, int data_offset) {
 		const bool mult = (data.size() - data_offset > 1);
-		const auto& graph_symbol = Symbols::graph_symbols.at(symbol + '_' + (invert ? "down" : "up"));
-		array<int, 2> result;
-		const float mod = (height == 1) ? 0.3 : 0.1;
 		long long data_value = 0;
 		if (mult and data_offset > 0) {
-			last = data.at(data_offset - 1);
+			last = data[data_offset - 1];
 			if (max_value > 0) last = clamp((last + offset) * 100 / max_value, 0ll, 100ll);
 		}
 
-		//? Horizontal iteration over values in <data>
-		for (const int& i : iota(data_offset, (int)data.size())) {
+		//? Horizontal iteration over values in <data>, each value replaces the oldest column of the current representation
+		for (int i = data_offset; i < (int)data.size(); i++) {
 			// if (tty_mode and mult and i % 2 != 0) continue;
 			if (not tty_mode and mult) current = not current;
 			if (i < 0) {
@@ -371,63 +384,82 @@ namespace Draw {
 				last = 0;
 			}
 			else {
-				data_value = data.at(i);
+				data_value = data[i];
 				if (max_value > 0) data_value = clamp((data_value + offset) * 100 / max_value, 0ll, 100ll);
 			}
-
-			//? Vertical iteration over height of graph
-			for (const int& horizon : iota(0, height)) {
-				const int cur_high = (height > 1) ? round(100.0 * (height - horizon) / height) : 100;
-				const int cur_low = (height > 1) ? round(100.0 * (height - (horizon + 1)) / height) : 0;
-				//? Calculate previous + current value to fit two values in 1 braille character
-				for (int ai = 0; const auto& value : {last, data_value}) {
-					const int clamp_min = (no_zero and horizon == height - 1 and not (mult and i == data_offset and ai == 0)) ? 1 : 0;
-					if (value >= cur_high)
-						result[ai++] = 4;
-					else if (value <= cur_low)
-						result[ai++] = clamp_min;
-					else {
-						result[ai++] = clamp((int)round((float)(value - cur_low) * 4 / (cur_high - cur_low) + mod), clamp_min, 4);
-					}
+			if (width < 1) continue;
+			const int col = head[current];
+			head[current] = (col + 1 == width ? 0 : col + 1);
+
+			//? Vertical iteration over height of graph, previous + current value fit in 1 braille character
+			const int last_index = clamp(last, 0ll, 100ll), value_index = clamp(data_value, 0ll, 100ll);
+			const uint8_t color = (uint8_t)max(last_index, value_index);
+			for (int horizon = 0; horizon < height; horizon++) {
+				const uint8_t* row_levels = &levels[horizon * 101];
+				int last_level = row_levels[last_index], value_level = row_levels[value_index];
+				if (no_zero and horizon == height - 1) {
+					if (not (mult and i == data_offset)) last_level = max(last_level, 1);
+					value_level = max(value_level, 1);
 				}
-				//? Generate graph symbol from 5x5 2D vector
-				if (height == 1) {
-					if (result.at(0) + result.at(1) == 0) graphs.at(current).at(horizon) += Mv::r(1);
-					else {
-						if (not color_gradient.empty()) graphs.at(current).at(horizon) += Theme::g(color_gradient).at(clamp(max(last, data_value), 0ll, 100ll));
-						graphs.at(current).at(horizon) += graph_symbol.at((result.at(0) * 5 + result.at(1)));
-					}
-				}
-				else graphs.at(current).at(horizon) += graph_symbol.at((result.at(0) * 5 + result.at(1)));
+
+				//? Save index into the 5x5 symbol table, empty single row cells are skipped with a cursor move
+				auto& c = cells[current][horizon * width + col];
+				if (height == 1 and last_level + value_level == 0) c = {};
+				else c = { (uint8_t)(last_level * 5 + value_level), color };
 			}
 			if (mult and i >= 0) last = data_value;
 		}
 		last = data_value;
+		_render();
+	}
+
+	void Graph::_render() {
 		out.clear();
+		Esc::writer w(out);
+		const auto& ring = cells[current];
+		const int start = head[current];
+
+		//? Columns from oldest to newest
+		auto add_row = [&](const int row) {
+			if (width < 1 or ring.empty()) return;
+			const cell* cols = &ring[row * width];
+			for (int n = 0, col = start; n < width; n++, col = (col + 1 == width ? 0 : col + 1)) {
+				const auto& c = cols[col];
+				if (c.glyph == blank) {
+					if (height == 1) w << Esc::r(1);
+					else w << ' ';
+					continue;
+				}
+				if (height == 1 and gradient != nullptr) w << gradient->at(c.color);
+				w << (*symbols)[c.glyph];
+			}
+		};
+
 		if (height == 1) {
-			if (not color_gradient.empty())
-				out += (last < 1 and not color_gradient.empty() ? Theme::c("inactive_fg") : Theme::g(color_gradient).at(clamp(last, 0ll, 100ll)));
-			out += graphs.at(current).at(0);
+			if (gradient != nullptr)
+				w << (last < 1 ? Theme::c("inactive_fg") : gradient->at(clamp(last, 0ll, 100ll)));
+			add_row(0);
 		}
 		else {
-			for (const int& i : iota(1, height + 1)) {
-				if (i > 1) out += Mv::d(1) + Mv::l(width);
-				if (not color_gradient.empty())
-					out += (invert) ? Theme::g(color_gradient).at(i * 100 / height) : Theme::g(color_gradient).at(100 - ((i - 1) * 100 / height));
-				out += (invert) ? graphs.at(current).at(height - i) : graphs.at(current).at(i-1);
+			for (int i = 1; i <= height; i++) {
+				if (i > 1) w << Esc::d(1) << Esc::l(width);
+				if (gradient != nullptr)
+					w << ((invert) ? gradient->at(i * 100 / height) : gradient->at(100 - ((i - 1) * 100 / height)));
+				add_row((invert) ? height - i : i - 1);
 			}
 		}
-		if (not color_gradient.empty()) out += Fx::reset;
+		if (gradient != nullptr) w << Fx::reset;
 	}
 
 	Graph::Graph() {}
 
-	Graph::Graph(int width, int height, const string& color_gradient, const deque<long long>& data, const string& symbol, bool invert, bool no_zero, long long max_value, long long offset)
-	: width(width), height(height), color_gradient(color_gradient), invert(invert), no_zero(no_zero), offset(offset) {
+	Graph::Graph(int width, int height, const string& color_gradient, span<const long long> data, const string& symbol, bool invert, bool no_zero, long long max_value, long long offset)
+	: width(width), height(height), gradient(color_gradient.empty() ? nullptr : &Theme::g(color_gradient)), invert(invert), no_zero(no_zero), offset(offset) {
 		if (Config::getB("tty_mode") or symbol == "tty") this->symbol = "tty";
 		else if (symbol != "default") this->symbol = symbol;
 		else this->symbol = Config::getS("graph_symbol");
 		if (this->symbol == "tty") tty_mode = true;
+		symbols = &Symbols::graph_symbols.at(this->symbol + '_' + (invert ? "down" : "up"));
 
 		if (max_value == 0 and offset > 0) max_value = 100;
 		this->max_value = max_value;
@@ -438,28 +470,30 @@ namespace Draw {
 			data_offset--;
 		}
 
-		//? Populate the two switching graph vectors and fill empty space if data size < width
-		for (const int& i : iota(0, height * 2)) {
-			if (tty_mode and bool(i % 2) != current) continue;
-			graphs[(i % 2 != 0)].push_back((value_width < width) ? ((height == 1) ? Mv::r(1) : " "s) * (width - value_width) : "");
+		//? Dot level for each value 0-100 in each row, values below 0 or above 100 are clamped as they are always below or above the row
+		const float mod = (height == 1) ? 0.3 : 0.1;
+		levels.resize(max(0, height) * 101);
+		for (int horizon = 0; horizon < height; horizon++) {
+			const int cur_high = (height > 1) ? round(100.0 * (height - horizon) / height) : 100;
+			const int cur_low = (height > 1) ? round(100.0 * (height - (horizon + 1)) / height) : 0;
+			for (int value = 0; value <= 100; value++) {
+				if (value >= cur_high) levels[horizon * 101 + value] = 4;
+				else if (value <= cur_low) levels[horizon * 101 + value] = 0;
+				else levels[horizon * 101 + value] = clamp((int)round((float)(value - cur_low) * 4 / (cur_high - cur_low) + mod), 0, 4);
+			}
 		}
+
+		//? Both representations start as empty space, columns not filled by <data> stay empty
+		for (auto& ring : cells) ring.assign(max(0, width) * max(0, height), cell{});
 		if (data.size() == 0) return;
 		this->_create(data, data_offset);
 	}
 
-	string& Graph::operator()(const deque<long long>& data, const bool data_same) {
+	string& Graph::operator()(span<const long long> data, const bool data_same) {
 		if (data_same) return out;
 
-		//? Make room for new characters on graph
+		//? Switch representation, the new column replaces the oldest one
 		if (not tty_mode) current = not current;
-		for (const int& i : iota(0, height)) {
-			if (height == 1 and graphs.at(current).at(i).at(1) == '[') {
-				if (graphs.at(current).at(i).at(3) == 'C') graphs.at(current).at(i).erase(0, 4);
-				else graphs.at(current).at(i).erase(0, graphs.at(current).at(i).find_first_of('m') + 4);
-			}
-			else if (graphs.at(current).at(i).at(0) == ' ') graphs.at(current).at(i).erase(0, 1);
-			else graphs.at(current).at(i).erase(0, 3);
-		}
 		this->_create(data, (int)data.size() - 1);
 		return out;
 	}
@@ -480,6 +514,8 @@ namespace Cpu {
 	int graph_up_height;
 	bool shown = true, redraw = true, mid_line = false;
 	string box;
+	string chrome; //* Static layer, box outline, buttons and labels, only written on redraw cycles
+	string out; //* Dynamic layer, reused every cycle, both are returned as views from draw()
 	Draw::Graph graph_upper;
 	Draw::Graph graph_lower;
 	Draw::Meter cpu_meter;
@@ -488,8 +524,11 @@ namespace Cpu {
 	vector<Draw::Graph> core_graphs;
 	vector<Draw::Graph> temp_graphs;
 
-	string draw(const cpu_info& cpu, const bool force_redraw, const bool data_same) {
-		if (Runner::stopping) return "";
+	Draw::layers draw(const cpu_info& cpu, const bool force_redraw, const bool data_same) {
+		out.clear();
+		chrome.clear();
+		Esc::writer w(out), c(chrome);
+		if (Runner::stopping) return {};
 		if (force_redraw) redraw = true;
 		const bool show_temps = (Config::getB("check_temp") and got_sensors);
 		auto& single_graph = Config::getB("cpu_single_graph");
@@ -498,52 +537,54 @@ namespace Cpu {
 		const int extra_width = (b_column_size > 0 and (hide_cores or not show_temps) ? max(6, 6 * b_column_size) : 0);
 		auto& graph_up_field = Config::getS("cpu_graph_upper");
 		auto& graph_lo_field = (Config::getS("cpu_graph_lower") == "gpu" and not show_gpu ? "total"s : Config::getS("cpu_graph_lower"));
+		const auto graph_up = field_index(graph_up_field), graph_lo = field_index(graph_lo_field);
 		auto& tty_mode = Config::getB("tty_mode");
 		auto& graph_symbol = (tty_mode ? "tty" : Config::getS("graph_symbol_cpu"));
 		auto& graph_bg = Symbols::graph_symbols.at((graph_symbol == "default" ? Config::getS("graph_symbol") + "_up" : graph_symbol + "_up")).at(6);
 		auto& temp_scale = Config::getS("temp_scale");
 		auto& cpu_bottom = Config::getB("cpu_bottom");
-		const string& title_left = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
-		const string& title_right = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_right_down : Symbols::title_right);
+		static string title_left, title_right;
 		static int bat_pos = 0, bat_len = 0;
-		if (cpu.cpu_percent.at("total").empty() or cpu.core_percent.at(0).empty() or (show_temps and cpu.temp.at(0).empty())) return box;
-		string out;
+		if (cpu.cpu_percent[CFtotal].empty() or cpu.core_percent.at(0).empty() or (show_temps and cpu.temp.at(0).empty())) return {box, {}};
 		out.reserve(width * height);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
+			//? Title ends only change with the theme and cpu_bottom, which both redraw the box
+			title_left = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
+			title_right = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_right_down : Symbols::title_right);
 			mid_line = (not single_graph and graph_up_field != graph_lo_field);
 			graph_up_height = (single_graph ? height - 2 : ceil((double)(height - 2) / 2) - (mid_line and height % 2 != 0 ? 1 : 0));
 			const int graph_low_height = height - 2 - graph_up_height - (mid_line ? 1 : 0);
 			const int button_y = cpu_bottom ? y + height - 1 : y;
-			out += box;
+			c << box;
 
 			//? Buttons on title
-			out += Mv::to(button_y, x + 10) + title_left + Theme::c("hi_fg") + Fx::b + 'm' + Theme::c("title") + "enu" + Fx::ub + title_right;
+			c << Esc::to(button_y, x + 10) << title_left << Theme::c("hi_fg") << Fx::b << 'm' << Theme::c("title") << "enu" << Fx::ub << title_right;
 			Input::mouse_mappings["m"] = {button_y, x + 11, 1, 4};
-			out += Mv::to(button_y, x + 16) + title_left + Theme::c("hi_fg") + Fx::b + 'p' + Theme::c("title") + "reset "
-				+ (Config::current_preset < 0 ? "*" : to_string(Config::current_preset)) + Fx::ub + title_right;
+			c << Esc::to(button_y, x + 16) << title_left << Theme::c("hi_fg") << Fx::b << 'p' << Theme::c("title") << "reset "
+				<< (Config::current_preset < 0 ? "*" : to_string(Config::current_preset)) << Fx::ub << title_right;
 			Input::mouse_mappings["p"] = {button_y, x + 17, 1, 8};
 			const string update = to_string(Config::getI("update_ms")) + "ms";
-			out += Mv::to(button_y, x + width - update.size() - 8) + title_left + Fx::b + Theme::c("hi_fg") + "- " + Theme::c("title") + update
-				+ Theme::c("hi_fg") + " +" + Fx::ub + title_right;
+			c << Esc::to(button_y, x + width - update.size() - 8) << title_left << Fx::b << Theme::c("hi_fg") << "- " << Theme::c("title") << update
+				<< Theme::c("hi_fg") << " +" << Fx::ub << title_right;
 			Input::mouse_mappings["-"] = {button_y, x + width - (int)update.size() - 7, 1, 2};
 			Input::mouse_mappings["+"] = {button_y, x + width - 5, 1, 2};
 
 			//? Graphs & meters
-			graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", cpu.cpu_percent.at(graph_up_field), graph_symbol, false, true};
+			graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", cpu.cpu_percent[graph_up], graph_symbol, false, true};
 			cpu_meter = Draw::Meter{b_width - (show_temps ? 23 - (b_column_size <= 1 and b_columns == 1 ? 6 : 0) : 11), "cpu"};
 			if (show_gpu) {
 				gpu_meter = Draw::Meter{ b_width - 23 - (b_column_size <= 1 and b_columns == 1 ? 6 : 0), "cpu" };
 			}
 			if (not single_graph)
-				graph_lower = Draw::Graph{x + width - b_width - 3, graph_low_height, "cpu", cpu.cpu_percent.at(graph_lo_field), graph_symbol, Config::getB("cpu_invert_lower"), true};
+				graph_lower = Draw::Graph{x + width - b_width - 3, graph_low_height, "cpu", cpu.cpu_percent[graph_lo], graph_symbol, Config::getB("cpu_invert_lower"), true};
 			if (mid_line) {
 				auto upper_text = (graph_up_field == "total" and graph_lo_field == "gpu" ? "cpu"s : graph_up_field);
-				out += Mv::to(y + graph_up_height + 1, x) + Fx::ub + Theme::c("cpu_box") + Symbols::div_left + Theme::c("div_line")
-					+ Symbols::h_line * (width - b_width - 2) + Symbols::div_right
-					+ Mv::to(y + graph_up_height + 1, x + ((width - b_width) / 2) - ((upper_text.size() + graph_lo_field.size()) / 2) - 4)
-					+ Theme::c("main_fg") + upper_text + Mv::r(1) + "▲▼" + Mv::r(1) + graph_lo_field;
+				c << Esc::to(y + graph_up_height + 1, x) << Fx::ub << Theme::c("cpu_box") << Symbols::div_left << Theme::c("div_line")
+					<< Esc::repeat(Symbols::h_line, width - b_width - 2) << Symbols::div_right
+					<< Esc::to(y + graph_up_height + 1, x + ((width - b_width) / 2) - ((upper_text.size() + graph_lo_field.size()) / 2) - 4)
+					<< Theme::c("main_fg") << upper_text << Esc::r(1) << "▲▼" << Esc::r(1) << graph_lo_field;
 			}
 			if (b_column_size > 0 or extra_width > 0) {
 				core_graphs.clear();
@@ -563,8 +604,8 @@ namespace Cpu {
 
 			if (show_gpu) {
 				gpu_temp = Draw::Graph{ 5, 1, "temp", cpu.gpu_temp, graph_symbol, false, false, 90, -23 };
-				out += Mv::to(b_y + b_height - 1, b_x + 3) + Fx::ub + Theme::c("div_line") + Symbols::h_line * (b_width - 14) + Mv::l(b_width - 13)
-					+ Symbols::title_left_down + Fx::b + Theme::c("title") + uresize(gpu_name, b_width - 15) + Fx::ub + Theme::c("div_line") + Symbols::title_right_down;
+				c << Esc::to(b_y + b_height - 1, b_x + 3) << Fx::ub << Theme::c("div_line") << Esc::repeat(Symbols::h_line, b_width - 14) << Esc::l(b_width - 13)
+					<< Symbols::title_left_down << Fx::b << Theme::c("title") << uresize(gpu_name, b_width - 15) << Fx::ub << Theme::c("div_line") << Symbols::title_right_down;
 			}
 		}
 
@@ -594,25 +635,25 @@ namespace Cpu {
 				const int current_pos = Term::width - current_len - 17;
 
 				if ((bat_pos != current_pos or bat_len != current_len) and bat_pos > 0 and not redraw)
-					out += Mv::to(y, bat_pos) + Fx::ub + Theme::c("cpu_box") + Symbols::h_line * (bat_len + 4);
+					w << Esc::to(y, bat_pos) << Fx::ub << Theme::c("cpu_box") << Esc::repeat(Symbols::h_line, bat_len + 4);
 				bat_pos = current_pos;
 				bat_len = current_len;
 
-				out += Mv::to(y, bat_pos) + title_left + Theme::c("title") + Fx::b + "BAT" + bat_symbol + ' ' + str_percent
-					+ (Term::width >= 100 ? Fx::ub + ' ' + bat_meter(percent) + Fx::b : "")
-					+ (not str_time.empty() ? ' ' + Theme::c("title") + str_time : " ") + Fx::ub + title_right;
+				w << Esc::to(y, bat_pos) << title_left << Theme::c("title") << Fx::b << "BAT" << bat_symbol << ' ' << str_percent
+					<< (Term::width >= 100 ? Fx::ub + ' ' + bat_meter(percent) + Fx::b : "")
+					<< (not str_time.empty() ? ' ' + Theme::c("title") + str_time : " ") << Fx::ub << title_right;
 			}
 		}
 		else if (bat_pos > 0) {
-			out += Mv::to(y, bat_pos) + Fx::ub + Theme::c("cpu_box") + Symbols::h_line * (bat_len + 4);
+			w << Esc::to(y, bat_pos) << Fx::ub << Theme::c("cpu_box") << Esc::repeat(Symbols::h_line, bat_len + 4);
 			bat_pos = bat_len = 0;
 		}
 
 		try {
 		//? Cpu graphs
-		out += Fx::ub + Mv::to(y + 1, x + 1) + graph_upper(cpu.cpu_percent.at(graph_up_field), (data_same or redraw));
+		w << Fx::ub << Esc::to(y + 1, x + 1) << graph_upper(cpu.cpu_percent[graph_up], (data_same or redraw));
 		if (not single_graph)
-			out += Mv::to( y + graph_up_height + 1 + (mid_line ? 1 : 0), x + 1) + graph_lower(cpu.cpu_percent.at(graph_lo_field), (data_same or redraw));
+			w << Esc::to( y + graph_up_height + 1 + (mid_line ? 1 : 0), x + 1) << graph_lower(cpu.cpu_percent[graph_lo], (data_same or redraw));
 
 		//? Uptime
 		if (Config::getB("show_uptime")) {
@@ -621,22 +662,22 @@ namespace Cpu {
 				upstr.resize(upstr.size() - 3);
 				upstr = trans(upstr);
 			}
-			out += Mv::to(y + (single_graph or not Config::getB("cpu_invert_lower") ? 1 : height - 2), x + 2)
-				+ Theme::c("graph_text") + "up" + Mv::r(1) + upstr;
+			w << Esc::to(y + (single_graph or not Config::getB("cpu_invert_lower") ? 1 : height - 2), x + 2)
+				<< Theme::c("graph_text") << "up" << Esc::r(1) << upstr;
 		}
 
 		//? Cpu meter
-		out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "CPU " + cpu_meter(cpu.cpu_percent.at("total").back())
-			+ Theme::g("cpu").at(clamp(cpu.cpu_percent.at("total").back(), 0ll, 100ll)) + rjust(to_string(cpu.cpu_percent.at("total").back()), 4) + Theme::c("main_fg") + '%';
+		w << Esc::to(b_y + 1, b_x + 1) << Theme::c("main_fg") << Fx::b << "CPU " << cpu_meter(cpu.cpu_percent[CFtotal].back())
+			<< Theme::g("cpu").at(clamp(cpu.cpu_percent[CFtotal].back(), 0ll, 100ll)) << Esc::rjust(cpu.cpu_percent[CFtotal].back(), 4) << Theme::c("main_fg") << '%';
 		if (show_temps) {
 			const auto [temp, unit] = celsius_to(cpu.temp.at(0).back(), temp_scale);
 			const auto& temp_color = Theme::g("temp").at(clamp(cpu.temp.at(0).back() * 100 / cpu.temp_max, 0ll, 100ll));
 			if (b_column_size > 1 or b_columns > 1)
-				out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + temp_color
-					+ temp_graphs.at(0)(cpu.temp.at(0), data_same or redraw);
-			out += rjust(to_string(temp), 4) + Theme::c("main_fg") + unit;
+				w << ' ' << Theme::c("inactive_fg") << Esc::repeat(graph_bg, 5) << Esc::l(5) << temp_color
+					<< temp_graphs.at(0)(cpu.temp.at(0), data_same or redraw);
+			w << Esc::rjust(temp, 4) << Theme::c("main_fg") << unit;
 		}
-		out += Theme::c("div_line") + Symbols::v_line;
+		w << Theme::c("div_line") << Symbols::v_line;
 
 		} catch (const std::exception& e) { throw std::runtime_error("graphs, clock, meter : " + (string)e.what()); }
 
@@ -644,25 +685,25 @@ namespace Cpu {
 		int cx = 0, cy = 1, cc = 0, core_width = (b_column_size == 0 ? 2 : 3);
 		if (Shared::coreCount >= 100) core_width++;
 		for (const auto& n : iota(0, Shared::coreCount)) {
-			out += Mv::to(b_y + cy + 1, b_x + cx + 1) + Theme::c("main_fg") + (Shared::coreCount < 100 ? Fx::b + 'C' + Fx::ub : "")
-				+ ljust(to_string(n), core_width);
+			w << Esc::to(b_y + cy + 1, b_x + cx + 1) << Theme::c("main_fg") << (Shared::coreCount < 100 ? Fx::b + 'C' + Fx::ub : "")
+				<< Esc::ljust(n, core_width);
 			if (b_column_size > 0 or extra_width > 0)
-				out += Theme::c("inactive_fg") + graph_bg * (5 * b_column_size + extra_width) + Mv::l(5 * b_column_size + extra_width)
-					+ core_graphs.at(n)(cpu.core_percent.at(n), data_same or redraw);
+				w << Theme::c("inactive_fg") << Esc::repeat(graph_bg, 5 * b_column_size + extra_width) << Esc::l(5 * b_column_size + extra_width)
+					<< core_graphs.at(n)(cpu.core_percent.at(n), data_same or redraw);
 			
-			out += Theme::g("cpu").at(clamp(cpu.core_percent.at(n).back(), 0ll, 100ll));
-			out += rjust(to_string(cpu.core_percent.at(n).back()), (b_column_size < 2 ? 3 : 4)) + Theme::c("main_fg") + '%';
+			w << Theme::g("cpu").at(clamp(cpu.core_percent.at(n).back(), 0ll, 100ll));
+			w << Esc::rjust(cpu.core_percent.at(n).back(), (b_column_size < 2 ? 3 : 4)) << Theme::c("main_fg") << '%';
 
 			if (show_temps and not hide_cores) {
 				const auto [temp, unit] = celsius_to(cpu.temp.at(n+1).back(), temp_scale);
 				const auto& temp_color = Theme::g("temp").at(clamp(cpu.temp.at(n+1).back() * 100 / cpu.temp_max, 0ll, 100ll));
 				if (b_column_size > 1)
-					out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5)
-						+ temp_graphs.at(n+1)(cpu.temp.at(n+1), data_same or redraw);
-				out += temp_color + rjust(to_string(temp), 4) + Theme::c("main_fg") + unit;
+					w << ' ' << Theme::c("inactive_fg") << Esc::repeat(graph_bg, 5) << Esc::l(5)
+						<< temp_graphs.at(n+1)(cpu.temp.at(n+1), data_same or redraw);
+				w << temp_color << Esc::rjust(temp, 4) << Theme::c("main_fg") << unit;
 			}
 
-			out += Theme::c("div_line") + Symbols::v_line;
+			w << Theme::c("div_line") << Symbols::v_line;
 
 			if ((++cy > ceil((double)Shared::coreCount / b_columns) or cy == b_height - 2) and n != Shared::coreCount - 1) {
 				if (++cc >= b_columns) break;
@@ -680,38 +721,39 @@ namespace Cpu {
 			for (const auto& val : cpu.load_avg) {
 				lavg += string(sep, ' ') + (lavg_pre.size() < 3 ? to_string((int)round(val)) : to_string(val).substr(0, 4));
 			}
-			out += Mv::to(b_y + b_height - 2 - (show_gpu ? 1 : 0), b_x + cx + 1) + Theme::c("main_fg") + lavg_pre + lavg;
+			w << Esc::to(b_y + b_height - 2 - (show_gpu ? 1 : 0), b_x + cx + 1) << Theme::c("main_fg") << lavg_pre << lavg;
 			cy++;
 		}
 
 		//? Gpu Stats
 		if (show_gpu and cy < b_height - 2 and cc <= b_columns) {
-			out += Mv::to(b_y + b_height - 2, b_x + 1) + Theme::c("main_fg") + Fx::b + "GPU " + gpu_meter(cpu.cpu_percent.at("gpu").back())
-				+ Theme::g("cpu").at(clamp(cpu.cpu_percent.at("gpu").back(), 0ll, 100ll)) + rjust(to_string(cpu.cpu_percent.at("gpu").back()), 4) + Theme::c("main_fg") + '%';
+			w << Esc::to(b_y + b_height - 2, b_x + 1) << Theme::c("main_fg") << Fx::b << "GPU " << gpu_meter(cpu.cpu_percent[CFgpu].back())
+				<< Theme::g("cpu").at(clamp(cpu.cpu_percent[CFgpu].back(), 0ll, 100ll)) << Esc::rjust(cpu.cpu_percent[CFgpu].back(), 4) << Theme::c("main_fg") << '%';
 			
 			const auto& temp_color = Theme::g("temp").at(clamp(cpu.gpu_temp.back(), 0ll, 100ll));
 			const auto [temp, unit] = celsius_to(cpu.gpu_temp.back(), temp_scale);
 			if ((b_column_size > 1 or b_columns > 1)) {
-				out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + gpu_temp(cpu.gpu_temp, data_same or redraw);
+				w << ' ' << Theme::c("inactive_fg") << Esc::repeat(graph_bg, 5) << Esc::l(5) << gpu_temp(cpu.gpu_temp, data_same or redraw);
 			}
-			out += temp_color + rjust(to_string(temp), 4) + Theme::c("main_fg") + unit;
+			w << temp_color << Esc::rjust(temp, 4) << Theme::c("main_fg") << unit;
 			
 		}
 
 		//? Cpu clock
 		if (not cpuHz.empty()) {
-			out += Mv::to(b_y, b_x + b_width - 10) + Fx::ub + Theme::c("div_line") + Symbols::h_line * (7 - cpuHz.size())
-				+ Symbols::title_left + Fx::b + Theme::c("title") + cpuHz + Fx::ub + Theme::c("div_line") + Symbols::title_right;
+			w << Esc::to(b_y, b_x + b_width - 10) << Fx::ub << Theme::c("div_line") << Esc::repeat(Symbols::h_line, 7 - cpuHz.size())
+				<< Symbols::title_left << Fx::b << Theme::c("title") << cpuHz << Fx::ub << Theme::c("div_line") << Symbols::title_right;
 		}
 
 		//? Gpu clock
 		if (show_gpu and not gpu_clock.empty()) {
-			out += Mv::to(b_y + b_height - 1, b_x + b_width - 11) + Fx::ub + Theme::c("div_line") + Symbols::h_line * (8 - gpu_clock.size())
-				+ Symbols::title_left_down + Fx::b + Theme::c("title") + gpu_clock + Fx::ub + Theme::c("div_line") + Symbols::title_right_down;
+			w << Esc::to(b_y + b_height - 1, b_x + b_width - 11) << Fx::ub << Theme::c("div_line") << Esc::repeat(Symbols::h_line, 8 - gpu_clock.size())
+				<< Symbols::title_left_down << Fx::b << Theme::c("title") << gpu_clock << Fx::ub << Theme::c("div_line") << Symbols::title_right_down;
 		}
 
 		redraw = false;
-		return out + Fx::reset;
+		w << Fx::reset;
+		return {chrome, out};
 	}
 
 }
@@ -725,14 +767,19 @@ namespace Mem {
 	int disks_io_half = 0;
 	bool shown = true, redraw = true;
 	string box;
-	unordered_flat_map<string, Draw::Meter> mem_meters;
-	unordered_flat_map<string, Draw::Graph> mem_graphs;
+	string chrome;
+	string out;
+	array<Draw::Meter, MScount> mem_meters;
+	array<Draw::Graph, MScount> mem_graphs;
 	unordered_flat_map<string, Draw::Meter> disk_meters_used;
 	unordered_flat_map<string, Draw::Meter> disk_meters_free;
 	unordered_flat_map<string, Draw::Graph> io_graphs;
 
-	string draw(const mem_info& mem, const bool force_redraw, const bool data_same) {
-		if (Runner::stopping) return "";
+	Draw::layers draw(const mem_info& mem, const bool force_redraw, const bool data_same) {
+		out.clear();
+		chrome.clear();
+		Esc::writer w(out), c(chrome);
+		if (Runner::stopping) return {};
 		if (force_redraw) redraw = true;
 		auto& show_swap = Config::getB("show_page");
 		auto& show_disks = Config::getB("show_disks");
@@ -744,40 +791,39 @@ namespace Mem {
 		auto& graph_symbol = (tty_mode ? "tty" : Config::getS("graph_symbol_mem"));
 		auto& graph_bg = Symbols::graph_symbols.at((graph_symbol == "default" ? Config::getS("graph_symbol") + "_up" : graph_symbol + "_up")).at(6);
 		const bool show_gpu = (Cpu::has_gpu and Config::getB("show_gpu"));
-		string out;
 		out.reserve(height * width);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
-			out += box;
-			mem_meters.clear();
-			mem_graphs.clear();
+			c << box;
+			mem_meters = {};
+			mem_graphs = {};
 			disk_meters_free.clear();
 			disk_meters_used.clear();
 			io_graphs.clear();
 
 			//? Mem graphs and meters
 			
-			for (const string name : { "used", "available", "cached", "commit" }) {
-				const string color = (name == "commit" ? "available" : name == "available" ? "free" : name);
+			for (const auto field : { MSused, MSavailable, MScached, MScommit }) {
+				const string color = (field == MScommit ? "available" : field == MSavailable ? "free" : stat_names[field]);
 				if (use_graphs)
-					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, color, mem.percent.at(name), graph_symbol};
+					mem_graphs[field] = Draw::Graph{mem_meter, graph_height, color, mem.percent[field], graph_symbol};
 				else
-					mem_meters[name] = Draw::Meter{ mem_meter, color };
+					mem_meters[field] = Draw::Meter{ mem_meter, color };
 			}
 
 			if (show_gpu) {
 				if (use_graphs)
-					mem_graphs["gpu_used"] = Draw::Graph{ mem_meter, graph_height, "cpu", mem.percent.at("gpu_used"), graph_symbol };
+					mem_graphs[MSgpu_used] = Draw::Graph{ mem_meter, graph_height, "cpu", mem.percent[MSgpu_used], graph_symbol };
 				else
-					mem_meters["gpu_used"] = Draw::Meter{ mem_meter, "cpu" };
+					mem_meters[MSgpu_used] = Draw::Meter{ mem_meter, "cpu" };
 			}
 
 			if (show_swap and has_swap) {
 				if (use_graphs)
-					mem_graphs["page_used"] = Draw::Graph{mem_meter, graph_height, "cpu", mem.percent.at("page_used"), graph_symbol};
+					mem_graphs[MSpage_used] = Draw::Graph{mem_meter, graph_height, "cpu", mem.percent[MSpage_used], graph_symbol};
 				else
-					mem_meters["page_used"] = Draw::Meter{mem_meter, "cpu"};
+					mem_meters[MSpage_used] = Draw::Meter{mem_meter, "cpu"};
 			}
 
 			//? Disk meters and io graphs
@@ -811,7 +857,7 @@ namespace Mem {
 							//? Create one combined graph for IO read/write if enabled
 							long long speed = static_cast<long long>(custom_speeds.contains(name) ? custom_speeds.at(name) : 100) << 20;
 							if (io_graph_combined) {
-								deque<long long> combined(disk.io_read.size(), 0);
+								vector<long long> combined(disk.io_read.size(), 0);
 								rng::transform(disk.io_read, disk.io_write, combined.begin(), std::plus<long long>());
 								io_graphs[name] = Draw::Graph{disks_width - (io_mode ? 0 : 6), disks_io_h, "available", combined, graph_symbol, false, true, speed};
 							}
@@ -831,8 +877,8 @@ namespace Mem {
 					 disk_meters_free[name] = Draw::Meter{disk_meter, (big_d ? "free" : "cpu"), not big_d};
 				}
 
-				out += Mv::to(y, x + width - 6) + Fx::ub + Theme::c("mem_box") + Symbols::title_left + (io_mode ? Fx::b : "") + Theme::c("hi_fg")
-				+ 'i' + Theme::c("title") + 'o' + Fx::ub + Theme::c("mem_box") + Symbols::title_right;
+				c << Esc::to(y, x + width - 6) << Fx::ub << Theme::c("mem_box") << Symbols::title_left << (io_mode ? Fx::b : "") << Theme::c("hi_fg")
+				<< 'i' << Theme::c("title") << 'o' << Fx::ub << Theme::c("mem_box") << Symbols::title_right;
 				Input::mouse_mappings["i"] = {y, x + width - 5, 1, 2};
 			}
 
@@ -845,55 +891,57 @@ namespace Mem {
 		string up = (graph_height >= 2 ? Mv::l(mem_width - 2) + Mv::u(graph_height - 1) : "");
 		bool big_mem = mem_width > 21;
 
-		out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + "Total:" + rjust(floating_humanizer(Mem::totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
-		vector<string> comb_names = {"used", "available", "cached", "commit"};
-		if (show_gpu) comb_names.insert(comb_names.end(), { "gpu_used" });
-		if (show_swap and has_swap) comb_names.insert(comb_names.end(), { "page_used" });
-		for (const auto& name : comb_names) {
+		w << Esc::to(y + 1, x + 2) << Theme::c("title") << Fx::b << "Total:" << rjust(floating_humanizer(Mem::totalMem), mem_width - 9) << Fx::ub << Theme::c("main_fg");
+		vector<Stats> comb_fields = { MSused, MSavailable, MScached, MScommit };
+		if (show_gpu) comb_fields.push_back(MSgpu_used);
+		if (show_swap and has_swap) comb_fields.push_back(MSpage_used);
+		for (const auto field : comb_fields) {
 			if (cy > height - 4) break;
 			string title;
-			if (name == "page_used") {
+			if (field == MSpage_used) {
 				if (cy > height - 5) break;
 				if (cy > 0 and height - cy > 6) {
-					if (graph_height > 0) out += Mv::to(y + 1 + cy, x + 1 + cx) + divider;
+					if (graph_height > 0) w << Esc::to(y + 1 + cy, x + 1 + cx) << divider;
 					cy += 1;
 				}
-				out += Mv::to(y + 1 + cy, x + 1 + cx) + Theme::c("title") + Fx::b + (mem.pagevirt ? "Page+Virt:" : "Pagefiles:")
-					+ rjust(floating_humanizer(mem.stats.at("page_total")), mem_width - 13) + Theme::c("main_fg") + Fx::ub;
+				w << Esc::to(y + 1 + cy, x + 1 + cx) << Theme::c("title") << Fx::b << (mem.pagevirt ? "Page+Virt:" : "Pagefiles:")
+					<< Esc::rjust(humanized(mem.stats[MSpage_total]), mem_width - 13) << Theme::c("main_fg") << Fx::ub;
 				cy += 1;
 				title = "Used";
 			}
-			else if (name == "gpu_used") {
+			else if (field == MSgpu_used) {
 				if (cy > height - 5) break;
 				if (cy > 0 and height - cy > 6) {
-					if (graph_height > 0) out += Mv::to(y + 1 + cy, x + 1 + cx) + divider;
+					if (graph_height > 0) w << Esc::to(y + 1 + cy, x + 1 + cx) << divider;
 					cy += 1;
 				}
-				out += Mv::to(y + 1 + cy, x + 1 + cx) + Theme::c("title") + Fx::b + "GPU" + (cpu_gpu ? " Shared" : "") + ":"
-					+ rjust(floating_humanizer(mem.stats.at("gpu_total")), mem_width - 7 - (cpu_gpu ? 7 : 0)) + Theme::c("main_fg") + Fx::ub;
+				w << Esc::to(y + 1 + cy, x + 1 + cx) << Theme::c("title") << Fx::b << "GPU" << (cpu_gpu ? " Shared" : "") << ":"
+					<< Esc::rjust(humanized(mem.stats[MSgpu_total]), mem_width - 7 - (cpu_gpu ? 7 : 0)) << Theme::c("main_fg") << Fx::ub;
 				cy += 1;
 				title = "Used";
 			}
 			else
-				title = capitalize(name);
+				title = capitalize(stat_names[field]);
 
-			const string humanized = floating_humanizer(mem.stats.at(name));
-			const int offset = max(0, divider.empty() ? 9 - (int)humanized.size() : 0);
-			const string graphics = (use_graphs ? mem_graphs.at(name)(mem.percent.at(name), redraw or data_same) : mem_meters.at(name)(mem.percent.at(name).back()));
+			const auto human = humanized(mem.stats[field]);
+			const int offset = max(0, divider.empty() ? 9 - (int)human.size() : 0);
+			const string graphics = (use_graphs ? mem_graphs[field](mem.percent[field], redraw or data_same) : mem_meters[field](mem.percent[field].back()));
 			if (mem_size > 2) {
-				out += Mv::to(y+1+cy, x+1+cx) + divider + title.substr(0, big_mem ? 10 : 5) + ":"
-					+ Mv::to(y+1+cy, x+cx + mem_width - 2 - humanized.size()) + (divider.empty() ? Mv::l(offset) + string(" ") * offset + humanized : trans(humanized))
-					+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(mem.percent.at(name).back()) + "%", 4);
+				w << Esc::to(y+1+cy, x+1+cx) << divider << title.substr(0, big_mem ? 10 : 5) << ":"
+					<< Esc::to(y+1+cy, x+cx + mem_width - 2 - human.size());
+				if (divider.empty()) w << Esc::l(offset) << Esc::repeat(" ", offset) << human;
+				else w << trans(human.str());
+				w << Esc::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) << graphics << up << Esc::rjust(mem.percent[field].back(), 3) << '%';
 				cy += (graph_height == 0 ? 2 : graph_height + 1);
 			}
 			else {
-				out += Mv::to(y+1+cy, x+1+cx) + ljust(title, (mem_size > 1 ? 5 : 1)) + (graph_height >= 2 ? "" : " ")
-					+ graphics + Theme::c("title") + rjust(humanized, (mem_size > 1 ? 9 : 7));
+				w << Esc::to(y+1+cy, x+1+cx) << ljust(title, (mem_size > 1 ? 5 : 1)) << (graph_height >= 2 ? "" : " ")
+					<< graphics << Theme::c("title") << Esc::rjust(human, (mem_size > 1 ? 9 : 7));
 				cy += (graph_height == 0 ? 1 : graph_height);
 			}
 		}
 		if (graph_height > 0 and cy < height - 2)
-			out += Mv::to(y+1+cy, x+1+cx) + divider;
+			w << Esc::to(y+1+cy, x+1+cx) << divider;
 
 		//? Disks
 		if (show_disks) {
@@ -909,31 +957,31 @@ namespace Mem {
 					const auto& disk = disks.at(mount);
 					if (disk.io_read.empty()) continue;
 					const string total = floating_humanizer(disk.total, not big_disk);
-					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c("title") + Fx::b + uresize(mount.front() + ": "s + disk.name, disks_width - 8) + Mv::to(y + 1 + cy, x + cx + disks_width - total.size())
-						+ trans(total) + Fx::ub;
+					w << Esc::to(y+1+cy, x+1+cx) << divider << Theme::c("title") << Fx::b << uresize(mount.front() + ": "s + disk.name, disks_width - 8) << Esc::to(y + 1 + cy, x + cx + disks_width - total.size())
+						<< trans(total) << Fx::ub;
 					if (big_disk) {
 						const string used_percent = to_string(disk.used_percent);
-						out += Mv::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)used_percent.size() / 2) - 1) + hu_div + used_percent + '%' + hu_div;
+						w << Esc::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)used_percent.size() / 2) - 1) << hu_div << used_percent << '%' << hu_div;
 					}
-					out += Mv::to(y+2+cy++, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c("inactive_fg") + graph_bg * (disks_width - 6)
-						+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c("main_fg");
+					w << Esc::to(y+2+cy++, x+1+cx) << (big_disk ? " IO% " : " IO   " + Mv::l(2)) << Theme::c("inactive_fg") << Esc::repeat(graph_bg, disks_width - 6)
+						<< Esc::l(disks_width - 6) << io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) << Theme::c("main_fg");
 					if (++cy > height - 3) break;
 					if (io_graph_combined) {
 						auto comb_val = disk.io_read.back() + disk.io_write.back();
 						const string humanized = (disk.io_write.back() > 0 ? "▼"s : ""s) + (disk.io_read.back() > 0 ? "▲"s : ""s)
 												+ (comb_val > 0 ? Mv::r(1) + floating_humanizer(comb_val, true) : "RW");
-						if (disks_io_h == 1) out += Mv::to(y+1+cy, x+1+cx) + string(5, ' ');
-						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount)({comb_val}, redraw or data_same)
-							+ Mv::to(y+1+cy, x+1+cx) + Theme::c("main_fg") + humanized;
+						if (disks_io_h == 1) w << Esc::to(y+1+cy, x+1+cx) << Esc::repeat(" ", 5);
+						w << Esc::to(y+1+cy, x+1+cx) << io_graphs.at(mount)(array{comb_val}, redraw or data_same)
+							<< Esc::to(y+1+cy, x+1+cx) << Theme::c("main_fg") << humanized;
 						cy += disks_io_h;
 					}
 					else {
 						const string human_read = (disk.io_read.back() > 0 ? "▲" + floating_humanizer(disk.io_read.back(), true) : "R");
 						const string human_write = (disk.io_write.back() > 0 ? "▼" + floating_humanizer(disk.io_write.back(), true) : "W");
-						if (disks_io_h <= 3) out += Mv::to(y+1+cy, x+1+cx) + string(5, ' ') + Mv::to(y+cy + disks_io_h, x+1+cx) + string(5, ' ');
-						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount + "_read")(disk.io_read, redraw or data_same) + Mv::l(disks_width)
-							+ Mv::d(1) + io_graphs.at(mount + "_write")(disk.io_write, redraw or data_same)
-							+ Mv::to(y+1+cy, x+1+cx) + human_read + Mv::to(y+cy + disks_io_h, x+1+cx) + human_write;
+						if (disks_io_h <= 3) w << Esc::to(y+1+cy, x+1+cx) << Esc::repeat(" ", 5) << Esc::to(y+cy + disks_io_h, x+1+cx) << Esc::repeat(" ", 5);
+						w << Esc::to(y+1+cy, x+1+cx) << io_graphs.at(mount + "_read")(disk.io_read, redraw or data_same) << Esc::l(disks_width)
+							<< Esc::d(1) << io_graphs.at(mount + "_write")(disk.io_write, redraw or data_same)
+							<< Esc::to(y+1+cy, x+1+cx) << human_read << Esc::to(y+cy + disks_io_h, x+1+cx) << human_write;
 						cy += disks_io_h;
 					}
 				}
@@ -950,45 +998,46 @@ namespace Mem {
 					const string human_used = floating_humanizer(disk.used, not big_disk);
 					const string human_free = floating_humanizer(disk.free, not big_disk);
 
-					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c("title") + Fx::b + uresize(mount.front() + ": "s + disk.name, disks_width - 8) + Mv::to(y + 1 + cy, x + cx + disks_width - human_total.size())
-						+ trans(human_total) + Fx::ub + Theme::c("main_fg");
+					w << Esc::to(y+1+cy, x+1+cx) << divider << Theme::c("title") << Fx::b << uresize(mount.front() + ": "s + disk.name, disks_width - 8) << Esc::to(y + 1 + cy, x + cx + disks_width - human_total.size())
+						<< trans(human_total) << Fx::ub << Theme::c("main_fg");
 					if (big_disk and not human_io.empty())
-						out += Mv::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)human_io.size() / 2) - 1) + hu_div + human_io + hu_div;
+						w << Esc::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)human_io.size() / 2) - 1) << hu_div << human_io << hu_div;
 					if (++cy > height - 3) break;
 					if (show_io_stat and io_graphs.contains(mount + "_activity")) {
-						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c("inactive_fg") + graph_bg * (disks_width - 6) + Theme::g("available").at(clamp(disk.io_activity.back(), 50ll, 100ll))
-							+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c("main_fg");
-						if (not big_disk) out += Mv::to(y+1+cy, x+cx+1) + Theme::c("main_fg") + human_io;
+						w << Esc::to(y+1+cy, x+1+cx) << (big_disk ? " IO% " : " IO   " + Mv::l(2)) << Theme::c("inactive_fg") << Esc::repeat(graph_bg, disks_width - 6) << Theme::g("available").at(clamp(disk.io_activity.back(), 50ll, 100ll))
+							<< Esc::l(disks_width - 6) << io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) << Theme::c("main_fg");
+						if (not big_disk) w << Esc::to(y+1+cy, x+cx+1) << Theme::c("main_fg") << human_io;
 						if (++cy > height - 3) break;
 					}
 
-					out += Mv::to(y + 1 + cy, x + 1 + cx) + (big_disk ? " Free:" + rjust(to_string(disk.free_percent) + '%', 4) : "F") + ' '
-						+ disk_meters_free.at(mount)(disk.free_percent) + rjust(human_free, (big_disk ? 9 : 5));
+					w << Esc::to(y + 1 + cy, x + 1 + cx) << (big_disk ? " Free:" + rjust(to_string(disk.free_percent) + '%', 4) : "F") << ' '
+						<< disk_meters_free.at(mount)(disk.free_percent) << rjust(human_free, (big_disk ? 9 : 5));
 					if (++cy > height - 3) break;
 
 					if (cmp_less_equal(disks.size() * 3 + (show_io_stat ? disk_ios : 0), height - 1)) {
-						out += Mv::to(y + 1 + cy, x + 1 + cx) + (big_disk ? " Used:" + rjust(to_string(disk.used_percent) + '%', 4) : "U") + ' ';
+						w << Esc::to(y + 1 + cy, x + 1 + cx) << (big_disk ? " Used:" + rjust(to_string(disk.used_percent) + '%', 4) : "U") << ' ';
 						// Only access disk_meters_used if it was created (when show_io_stat is enabled and big_disk condition is met)
 						if (show_io_stat and cmp_less_equal(mem.disks.size() * 3 + disk_ios, height - 1)) {
-							out += disk_meters_used.at(mount)(disk.used_percent);
+							w << disk_meters_used.at(mount)(disk.used_percent);
 						} else {
 							// Fallback to free meter with different styling when used meter is not available
-							out += disk_meters_free.at(mount)(disk.used_percent);
+							w << disk_meters_free.at(mount)(disk.used_percent);
 						}
-						out += rjust(human_used, (big_disk ? 9 : 5));
+						w << rjust(human_used, (big_disk ? 9 : 5));
 						cy++;
 						if (cmp_less_equal(disks.size() * 4 + (show_io_stat ? disk_ios : 0), height - 1)) cy++;
 					}
 
 				}
 			}
-			if (cy < height - 2) out += Mv::to(y+1+cy, x+1+cx) + divider;
+			if (cy < height - 2) w << Esc::to(y+1+cy, x+1+cx) << divider;
 		}
 
 
 
 		redraw = false;
-		return out + Fx::reset;
+		w << Fx::reset;
+		return {chrome, out};
 	}
 
 }
@@ -1000,11 +1049,16 @@ namespace Net {
 	int b_x, b_y, b_width, b_height, d_graph_height, u_graph_height;
 	bool shown = true, redraw = true;
 	string old_ip;
-	unordered_flat_map<string, Draw::Graph> graphs;
+	array<Draw::Graph, NDcount> graphs;
 	string box;
+	string chrome;
+	string out;
 
-	string draw(const net_info& net, const bool force_redraw, const bool data_same) {
-		if (Runner::stopping) return "";
+	Draw::layers draw(const net_info& net, const bool force_redraw, const bool data_same) {
+		out.clear();
+		chrome.clear();
+		Esc::writer w(out), c(chrome);
+		if (Runner::stopping) return {};
 		if (force_redraw) redraw = true;
 		auto& net_sync = Config::getB("net_sync");
 		auto& net_auto = Config::getB("net_auto");
@@ -1017,77 +1071,80 @@ namespace Net {
 			old_ip = ip_addr;
 			redraw = true;
 		}
-		string out;
 		out.reserve(width * height);
 		const string title_left = Theme::c("net_box") + Fx::ub + Symbols::title_left;
 		const string title_right = Theme::c("net_box") + Fx::ubul + Symbols::title_right;
 		const int i_size = min((int)selected_iface.size(), width - ip_size - 19);
-		const long long down_max = (net_auto ? graph_max.at("download") : ((long long)(Config::getI("net_download")) << 20) / 8);
-		const long long up_max = (net_auto ? graph_max.at("upload") : ((long long)(Config::getI("net_upload")) << 20) / 8);
+		const long long down_max = (net_auto ? graph_max[NDdownload] : ((long long)(Config::getI("net_download")) << 20) / 8);
+		const long long up_max = (net_auto ? graph_max[NDupload] : ((long long)(Config::getI("net_upload")) << 20) / 8);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
-			out = box;
+			c << box;
 			//? Graphs
-			graphs.clear();
-			if (net.bandwidth.at("download").empty() or net.bandwidth.at("upload").empty())
-				return out + Fx::reset;
-			graphs["download"] = Draw::Graph{width - b_width - 2, u_graph_height, "download", net.bandwidth.at("download"), graph_symbol, false, true, down_max};
-			graphs["upload"] = Draw::Graph{width - b_width - 2, d_graph_height, "upload", net.bandwidth.at("upload"), graph_symbol, true, true, up_max};
+			graphs = {};
+			if (net.bandwidth[NDdownload].empty() or net.bandwidth[NDupload].empty()) {
+				c << Fx::reset;
+				return {chrome, {}};
+			}
+			graphs[NDdownload] = Draw::Graph{width - b_width - 2, u_graph_height, dir_names[NDdownload], net.bandwidth[NDdownload], graph_symbol, false, true, down_max};
+			graphs[NDupload] = Draw::Graph{width - b_width - 2, d_graph_height, dir_names[NDupload], net.bandwidth[NDupload], graph_symbol, true, true, up_max};
 
 			//? Interface selector and buttons
 
-			out += Mv::to(y, x + width - i_size - 9) + title_left + Fx::b + Theme::c("hi_fg") + '<' + Theme::c("title") + ' '
-				+ uresize(selected_iface, i_size) + ' ' + Theme::c("hi_fg") + '>' + title_right;
+			c << Esc::to(y, x + width - i_size - 9) << title_left << Fx::b << Theme::c("hi_fg") << '<' << Theme::c("title") << ' '
+				<< uresize(selected_iface, i_size) << ' ' << Theme::c("hi_fg") << '>' << title_right;
 			Input::mouse_mappings["b"] = { y, x + width - i_size - 8, 1, 3 };
 			Input::mouse_mappings["n"] = { y, x + width - 6, 1, 3 };
 			if (width - i_size - ip_size - 20 > 4) {
-				out += Mv::to(y, x + width - i_size - 15) + title_left + Theme::c("hi_fg") + (net.stat.at("download").offset + net.stat.at("upload").offset > 0 ? Fx::bul : "") + 'z'
-					+ Theme::c("title") + "ero" + title_right;
+				c << Esc::to(y, x + width - i_size - 15) << title_left << Theme::c("hi_fg") << (net.stat[NDdownload].offset + net.stat[NDupload].offset > 0 ? Fx::bul : "") << 'z'
+					<< Theme::c("title") << "ero" << title_right;
 				Input::mouse_mappings["z"] = { y, x + width - i_size - 14, 1, 4 };
 			}
 			if (width - i_size - ip_size - 20 > 10) {
-				out += Mv::to(y, x+width - i_size - 21) + title_left + Theme::c("hi_fg") + (net_auto ? Fx::bul : "") + 'a' + Theme::c("title") + "uto" + title_right;
+				c << Esc::to(y, x+width - i_size - 21) << title_left << Theme::c("hi_fg") << (net_auto ? Fx::bul : "") << 'a' << Theme::c("title") << "uto" << title_right;
 				Input::mouse_mappings["a"] = {y, x+width - i_size - 20, 1, 4};
 			}
 			if (width - i_size - ip_size - 20 > 16) {
-				out += Mv::to(y, x+width - i_size - 27) + title_left + Theme::c("title") + (net_sync ? Fx::bul : "") + 's' + Theme::c("hi_fg")
-					+ 'y' + Theme::c("title") + "nc" + title_right;
+				c << Esc::to(y, x+width - i_size - 27) << title_left << Theme::c("title") << (net_sync ? Fx::bul : "") << 's' << Theme::c("hi_fg")
+					<< 'y' << Theme::c("title") << "nc" << title_right;
 				Input::mouse_mappings["y"] = {y, x+width - i_size - 26, 1, 4};
 			}
 		}
 
 		//? IP or device address
 		if (not ip_addr.empty()) {
-			out += Mv::to(y, x + 8) + title_left + Theme::c("title") + Fx::b + ip_addr + title_right;
+			w << Esc::to(y, x + 8) << title_left << Theme::c("title") << Fx::b << ip_addr << title_right;
 		}
 
 		//? Graphs and stats
 		int cy = 0;
-		for (const string dir : {"download", "upload"}) {
-			out += Mv::to(y+1 + (dir == "upload" ? u_graph_height : 0), x + 1) + graphs.at(dir)(net.bandwidth.at(dir), redraw or data_same or not net.connected)
-				+ Mv::to(y+1 + (dir == "upload" ? height - 3: 0), x + 1) + Fx::ub + Theme::c("graph_text")
-				+ floating_humanizer((dir == "upload" ? up_max : down_max), true);
-			const string speed = floating_humanizer(net.stat.at(dir).speed, false, 0, false, true);
-			const string speed_bits = (b_width >= 20 ? floating_humanizer(net.stat.at(dir).speed, false, 0, true, true) : "");
-			const string top = floating_humanizer(net.stat.at(dir).top, false, 0, true, true);
-			const string total = floating_humanizer(net.stat.at(dir).total);
-			const string symbol = (dir == "upload" ? "▲" : "▼");
-			out += Mv::to(b_y+1+cy, b_x+1) + Fx::ub + Theme::c("main_fg") + symbol + ' ' + ljust(speed, 10) + (b_width >= 20 ? rjust('(' + speed_bits + ')', 13) : "");
+		for (const auto dir : { NDdownload, NDupload }) {
+			w << Esc::to(y+1 + (dir == NDupload ? u_graph_height : 0), x + 1) << graphs[dir](net.bandwidth[dir], redraw or data_same or not net.connected)
+				<< Esc::to(y+1 + (dir == NDupload ? height - 3: 0), x + 1) << Fx::ub << Theme::c("graph_text")
+				<< humanized((dir == NDupload ? up_max : down_max), true);
+			const std::string_view symbol = (dir == NDupload ? "▲" : "▼");
+			w << Esc::to(b_y+1+cy, b_x+1) << Fx::ub << Theme::c("main_fg") << symbol << ' ' << Esc::ljust(humanized(net.stat[dir].speed, false, 0, false, true), 10);
+			if (b_width >= 20) {
+				const auto speed_bits = humanized(net.stat[dir].speed, false, 0, true, true);
+				w << Esc::repeat(" ", 11 - (int)speed_bits.size()) << '(' << speed_bits << ')';
+			}
 			cy += (b_height == 5 ? 2 : 1);
 			if (b_height >= 8) {
-				out += Mv::to(b_y+1+cy, b_x+1) + symbol + ' ' + "Top: " + rjust('(' + top, (b_width >= 20 ? 17 : 9)) + ')';
+				const auto top = humanized(net.stat[dir].top, false, 0, true, true);
+				w << Esc::to(b_y+1+cy, b_x+1) << symbol << ' ' << "Top: " << Esc::repeat(" ", (b_width >= 20 ? 16 : 8) - (int)top.size()) << '(' << top << ')';
 				cy++;
 			}
 			if (b_height >= 6) {
-				out += Mv::to(b_y+1+cy, b_x+1) + symbol + ' ' + "Total: " + rjust(total, (b_width >= 20 ? 16 : 8));
+				w << Esc::to(b_y+1+cy, b_x+1) << symbol << ' ' << "Total: " << Esc::rjust(humanized(net.stat[dir].total), (b_width >= 20 ? 16 : 8));
 				cy += (b_height > 6 and b_height % 2 ? 2 : 1);
 			}
 		}
 
 
 		redraw = false;
-		return out + Fx::reset;
+		w << Fx::reset;
+		return {chrome, out};
 	}
 
 }
@@ -1101,10 +1158,22 @@ namespace Proc {
 	int selected_pid = 0, selected_depth = 0;
 	string selected_name;
 	string selected_status;
-	unordered_flat_map<size_t, Draw::Graph> p_graphs;
+	graph_pool p_graphs;
 	unordered_flat_map<size_t, bool> p_wide_cmd;
-	unordered_flat_map<size_t, int> p_counters;
+
+	//* Rendered process line, <head> is written from the start of the line and <tail> from column <tail_col> if set,
+	//* no line positions are included so cached lines can be reused when the list scrolls. Each part is remade when its
+	//* key changes. <sweep> is the last sweep of the caches the line was drawn in
+	struct proc_row {
+		uint64_t head_key = 0, tail_key = 0;
+		int tail_col = 0;
+		uint32_t sweep = 0;
+		string head, tail;
+	};
+	unordered_flat_map<size_t, proc_row> p_rows;
+	string p_colors_end;
 	int counter = 0;
+	uint32_t sweeps = 0;
 	Draw::TextEdit filter;
 	Draw::Graph detailed_cpu_graph;
 	Draw::Graph detailed_mem_graph;
@@ -1112,6 +1181,55 @@ namespace Proc {
 	int dgraph_x, dgraph_width, d_width, d_x, d_y;
 
 	string box;
+	string chrome;
+	string out;
+
+	void graph_pool::reset(const size_t size) {
+		graphs.assign(size, {});
+		slots.assign(size, {});
+		index.clear();
+		index.reserve(size);
+		tick = 0;
+	}
+
+	const string* graph_pool::operator()(const size_t pid, const double cpu_p, const long long value, const bool data_same, const string& symbol) {
+		uint32_t i;
+		if (auto found = index.find(pid); found != index.end()) {
+			i = found->second;
+
+			//? Release the graph after 10 updates below 0.1%
+			if (not data_same) {
+				if (cpu_p < 0.1 and ++slots[i].idle >= 10) {
+					index.erase(pid);
+					slots[i] = {};
+					return nullptr;
+				}
+				else if (cpu_p >= 0.1) slots[i].idle = 0;
+			}
+		}
+		else {
+			if (cpu_p <= 0 or slots.empty()) return nullptr;
+
+			//? Take a free graph or the least recently shown one that isn't in view in this pass
+			i = 0;
+			for (uint32_t n = 0; n < slots.size(); n++) {
+				if (not slots[n].used) {
+					i = n;
+					break;
+				}
+				if (slots[n].shown < slots[i].shown) i = n;
+			}
+			if (slots[i].used) {
+				if (slots[i].shown == tick) return nullptr;
+				index.erase(slots[i].pid);
+			}
+			slots[i] = {pid, tick, 0, true};
+			index[pid] = i;
+			graphs[i] = Draw::Graph{5, 1, "", {}, symbol};
+		}
+		slots[i].shown = tick;
+		return &graphs[i](span(&value, 1), data_same);
+	}
 
 	int selection(const string& cmd_key) {
 		auto start = Config::getI("proc_start");
@@ -1173,8 +1291,11 @@ namespace Proc {
 		return (not changed ? -1 : selected);
 	}
 
-	string draw(const vector<proc_info>& plist, const bool force_redraw, const bool data_same) {
-		if (Runner::stopping) return "";
+	Draw::layers draw(const vector<proc_info>& plist, const bool force_redraw, const bool data_same) {
+		out.clear();
+		chrome.clear();
+		Esc::writer w(out), c(chrome);
+		if (Runner::stopping) return {};
 		auto& services = Config::getB("proc_services");
 		const bool proc_tree = (not services and Config::getB("proc_tree"));
 		const bool show_detailed = (Config::getB("show_detailed") and cmp_equal(Proc::detailed.last_pid, Config::getI("detailed_pid")));
@@ -1193,18 +1314,19 @@ namespace Proc {
 		const int select_max = show_detailed ? Proc::select_max - 8 : Proc::select_max;
 		int numpids = Proc::numpids;
 		if (force_redraw) redraw = true;
-		string out;
 		out.reserve(width * height);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
-			out = box;
+			c << box;
 			const string title_left = Theme::c("proc_box") + Symbols::title_left;
 			const string title_right = Theme::c("proc_box") + Symbols::title_right;
 			const string title_left_down = Theme::c("proc_box") + Symbols::title_left_down;
 			const string title_right_down = Theme::c("proc_box") + Symbols::title_right_down;
 			for (const auto& key : {"T", "K", "S", "enter"})
 				if (Input::mouse_mappings.contains(key)) Input::mouse_mappings.erase(key);
+			p_rows.clear();
+			p_colors_end = Theme::c("main_fg") + Fx::ub;
 
 			//? Adapt sizes of text fields
 			user_size = (width < 75 ? 5 : 10);
@@ -1228,55 +1350,55 @@ namespace Proc {
 					detailed_mem_graph = Draw::Graph{d_width / 3, 1, "", detailed.mem_bytes, graph_symbol, false, false, detailed.first_mem};
 				}
 				else if (detailed.cpu_percent.size() < 2) {
-					detailed_cpu_graph = Draw::Graph{ dgraph_width - 1, 7, "cpu", {0}, graph_symbol, false, false};
-					detailed_mem_graph = Draw::Graph{ d_width / 3, 1, "", {0}, graph_symbol, false, false, detailed.first_mem};
+					detailed_cpu_graph = Draw::Graph{ dgraph_width - 1, 7, "cpu", array{0ll}, graph_symbol, false, false};
+					detailed_mem_graph = Draw::Graph{ d_width / 3, 1, "", array{0ll}, graph_symbol, false, false, detailed.first_mem};
 				}
 
 				//? Draw structure of details box
 				const string pid_str = to_string(detailed.entry.pid);
-				out += Mv::to(y, x) + Theme::c("proc_box") + Symbols::div_left + Symbols::h_line + title_left + Theme::c("hi_fg") + Fx::b
-				+ (tty_mode ? "4" : Symbols::superscript.at(4)) + Theme::c("title") + "proc"
-					+ Fx::ub + title_right + Symbols::h_line * (width - 10) + Symbols::div_right
-					+ Mv::to(d_y, dgraph_x + 2) + title_left + Fx::b + Theme::c("title") + pid_str + Fx::ub + title_right
-					+ title_left + Fx::b + Theme::c("title") + uresize(detailed.entry.name, dgraph_width - pid_str.size() - 7, true) + Fx::ub + title_right;
+				c << Esc::to(y, x) << Theme::c("proc_box") << Symbols::div_left << Symbols::h_line << title_left << Theme::c("hi_fg") << Fx::b
+				<< (tty_mode ? "4" : Symbols::superscript.at(4)) << Theme::c("title") << "proc"
+					<< Fx::ub << title_right << Esc::repeat(Symbols::h_line, width - 10) << Symbols::div_right
+					<< Esc::to(d_y, dgraph_x + 2) << title_left << Fx::b << Theme::c("title") << pid_str << Fx::ub << title_right
+					<< title_left << Fx::b << Theme::c("title") << uresize(detailed.entry.name, dgraph_width - pid_str.size() - 7, true) << Fx::ub << title_right;
 
-				out += Mv::to(d_y, d_x - 1) + Theme::c("proc_box") + Symbols::div_up + Mv::to(y, d_x - 1) + Symbols::div_down + Theme::c("div_line");
-				for (const int& i : iota(1, 8)) out += Mv::to(d_y + i, d_x - 1) + Symbols::v_line;
+				c << Esc::to(d_y, d_x - 1) << Theme::c("proc_box") << Symbols::div_up << Esc::to(y, d_x - 1) << Symbols::div_down << Theme::c("div_line");
+				for (const int& i : iota(1, 8)) c << Esc::to(d_y + i, d_x - 1) << Symbols::v_line;
 
 				const string& t_color = ((not services and not alive) or selected > 0 ? Theme::c("inactive_fg") : Theme::c("title"));
 				const string& hi_color = ((not services and not alive) or selected > 0 ? t_color : Theme::c("hi_fg"));
 				const string hide = (selected > 0 ? t_color + "hide " : Theme::c("title") + "hide " + Theme::c("hi_fg"));
 				int mouse_x = d_x + 2;
-				out += Mv::to(d_y, d_x + 1);
+				c << Esc::to(d_y, d_x + 1);
 				if (services) {
 					if (detailed.can_stop and detailed.status != "Stopped") {
-						out += Fx::ub + title_left + Fx::b + t_color + 's' + hi_color + 't' + t_color + "op" + Fx::ub + title_right;
+						c << Fx::ub << title_left << Fx::b << t_color << 's' << hi_color << 't' << t_color << "op" << Fx::ub << title_right;
 						if (alive and selected == 0) Input::mouse_mappings["t"] = { d_y, mouse_x, 1, 4 };
 						mouse_x += 6;
 					}
 					else if (detailed.status == "Stopped") {
-						out += Fx::ub + title_left + Fx::b + t_color + 's' + hi_color + 't' + t_color + "art" + Fx::ub + title_right;
+						c << Fx::ub << title_left << Fx::b << t_color << 's' << hi_color << 't' << t_color << "art" << Fx::ub << title_right;
 						if (alive and selected == 0) Input::mouse_mappings["t"] = { d_y, mouse_x, 1, 5 };
 						mouse_x += 7;
 					}
 
 					if (detailed.can_pause and detailed.status == "Running") {
-						out += Fx::ub + title_left + Fx::b + t_color + "pa" + hi_color + 'u' + t_color + "se" + Fx::ub + title_right;
+						c << Fx::ub << title_left << Fx::b << t_color << "pa" << hi_color << 'u' << t_color << "se" << Fx::ub << title_right;
 						if (alive and selected == 0) Input::mouse_mappings["u"] = { d_y, mouse_x, 1, 5 };
 						mouse_x += 7;
 					}
 					else if (detailed.status == "Paused") {
-						out += Fx::ub + title_left + Fx::b + t_color + "contin" + hi_color + 'u' + t_color + 'e' + Fx::ub + title_right;
+						c << Fx::ub << title_left << Fx::b << t_color << "contin" << hi_color << 'u' << t_color << 'e' << Fx::ub << title_right;
 						if (alive and selected == 0) Input::mouse_mappings["u"] = { d_y, mouse_x, 1, 8 };
 						mouse_x += 10;
 					}
 					
-					out += Fx::ub + title_left + Fx::b + hi_color + 'S' + t_color + "tart-type" + Fx::ub + title_right;
+					c << Fx::ub << title_left << Fx::b << hi_color << 'S' << t_color << "tart-type" << Fx::ub << title_right;
 					if (selected == 0) Input::mouse_mappings["s"] = { d_y, mouse_x, 1, 10 };
 					mouse_x += 12;
 				}
 				else {
-					out += Fx::ub + title_left + hi_color + Fx::b + 't' + t_color + "erminate" + Fx::ub + title_right;
+					c << Fx::ub << title_left << hi_color << Fx::b << 't' << t_color << "erminate" << Fx::ub << title_right;
 					if (alive and selected == 0) Input::mouse_mappings["t"] = { d_y, mouse_x, 1, 9 };
 					mouse_x += 11;
 				}
@@ -1289,33 +1411,33 @@ namespace Proc {
 					mouse_x += 6;
 					Input::mouse_mappings["s"] = {d_y, mouse_x, 1, 7};
 				}*/
-				out += Mv::to(d_y, d_x + d_width - 10) + title_left + t_color + Fx::b + hide + Symbols::enter + Fx::ub + title_right;
+				c << Esc::to(d_y, d_x + d_width - 10) << title_left << t_color << Fx::b << hide << Symbols::enter << Fx::ub << title_right;
 				if (selected == 0) Input::mouse_mappings["enter"] = {d_y, d_x + d_width - 9, 1, 6};
 
 				//? Labels
 				const int item_fit = floor((double)(d_width - 2) / 10);
 				const int item_width = floor((double)(d_width - 2) / min(item_fit, 7));
-				out += Mv::to(d_y + 1, d_x + 1) + Fx::b + Theme::c("title")
-										+ cjust("Status:", item_width)
-										+ cjust("Elapsed:", item_width);
-				if (item_fit >= 3) out += cjust("IO/R:", item_width);
-				if (item_fit >= 4) out += cjust("IO/W:", item_width);
-				if (item_fit >= 5) out += cjust((services ? "Start:" : "Parent :"), item_width);
-				if (item_fit >= 6) out += cjust((services ? "Owner:" : "User:"), item_width);
-				if (item_fit >= 7) out += cjust("Threads:", item_width);
+				c << Esc::to(d_y + 1, d_x + 1) << Fx::b << Theme::c("title")
+										<< cjust("Status:", item_width)
+										<< cjust("Elapsed:", item_width);
+				if (item_fit >= 3) c << cjust("IO/R:", item_width);
+				if (item_fit >= 4) c << cjust("IO/W:", item_width);
+				if (item_fit >= 5) c << cjust((services ? "Start:" : "Parent :"), item_width);
+				if (item_fit >= 6) c << cjust((services ? "Owner:" : "User:"), item_width);
+				if (item_fit >= 7) c << cjust("Threads:", item_width);
 				//if (item_fit >= 8) out += cjust("Nice:", item_width);
 
 
 				//? Command line
 				for (int i = 0; const auto& l : (services ? array<const char, 3>{'D', 'S', 'C'} : array<const char, 3>{'C', 'M', 'D'}))
-				out += Mv::to(d_y + 5 + i++, d_x + 1) + l;
+				c << Esc::to(d_y + 5 + i++, d_x + 1) << l;
 
-				out += Theme::c("main_fg") + Fx::ub;
-				const string& text = (services ? detailed.description : detailed.entry.cmd);
+				c << Theme::c("main_fg") << Fx::ub;
+				const string& text = (services ? detailed.description : detailed.entry.text->cmd);
 				const int txt_size = ulen(text, true);
 				for (int num_lines = min(3, (int)ceil((double)txt_size / (d_width - 5))), i = 0; i < num_lines; i++) {
-					out += Mv::to(d_y + 5 + (num_lines == 1 ? 1 : i), d_x + 3)
-						+ cjust(luresize(text, txt_size - (d_width - 5) * i, true), d_width - 5, true, true);
+					c << Esc::to(d_y + 5 + (num_lines == 1 ? 1 : i), d_x + 3)
+						<< cjust(luresize(text, txt_size - (d_width - 5) * i, true), d_width - 5, true, true);
 				}
 
 			}
@@ -1323,10 +1445,10 @@ namespace Proc {
 			//? Filter
 			auto& filtering = Config::getB("proc_filtering"); // ? filter(20) : Config::getS("proc_filter"))
 			const auto filter_text = (filtering) ? filter(max(6, width - 58)) : uresize(Config::getS("proc_filter"), max(6, width - 58));
-			out += Mv::to(y, x+9) + title_left + (not filter_text.empty() ? Fx::b : "") + Theme::c("hi_fg") + 'f'
-				+ Theme::c("title") + (not filter_text.empty() ? ' ' + filter_text : "ilter")
-				+ (not filtering and not filter_text.empty() ? Theme::c("hi_fg") + " del" : "")
-				+ (filtering ? Theme::c("hi_fg") + ' ' + Symbols::enter : "") + Fx::ub + title_right;
+			c << Esc::to(y, x+9) << title_left << (not filter_text.empty() ? Fx::b : "") << Theme::c("hi_fg") << 'f'
+				<< Theme::c("title") << (not filter_text.empty() ? ' ' + filter_text : "ilter")
+				<< (not filtering and not filter_text.empty() ? Theme::c("hi_fg") + " del" : "")
+				<< (filtering ? Theme::c("hi_fg") + ' ' + Symbols::enter : "") << Fx::ub << title_right;
 			if (not filtering) {
 				int f_len = (filter_text.empty() ? 6 : ulen(filter_text) + 2);
 				Input::mouse_mappings["f"] = {y, x + 10, 1, f_len};
@@ -1341,27 +1463,27 @@ namespace Proc {
 			const int sort_pos = x + width - sort_len - 8;
 
 			if (width > 65 + sort_len) {
-				out += Mv::to(y, sort_pos - 35) + title_left + (Config::getB("proc_per_core") ? Fx::bul : "") + Theme::c("title")
-					+ "per-" + Theme::c("hi_fg") + 'c' + Theme::c("title") + "ore" + Fx::ubul + title_right;
+				c << Esc::to(y, sort_pos - 35) << title_left << (Config::getB("proc_per_core") ? Fx::bul : "") << Theme::c("title")
+					<< "per-" << Theme::c("hi_fg") << 'c' << Theme::c("title") << "ore" << Fx::ubul << title_right;
 				Input::mouse_mappings["c"] = {y, sort_pos - 34, 1, 8};
 			}
 			if (width > 55 + sort_len) {
-				out += Mv::to(y, sort_pos - 25) + title_left + (Config::getB("proc_reversed") ? Fx::bul : "") + Theme::c("hi_fg")
-					+ 'r' + Theme::c("title") + "everse" + Fx::ubul + title_right;
+				c << Esc::to(y, sort_pos - 25) << title_left << (Config::getB("proc_reversed") ? Fx::bul : "") << Theme::c("hi_fg")
+					<< 'r' << Theme::c("title") << "everse" << Fx::ubul << title_right;
 				Input::mouse_mappings["r"] = {y, sort_pos - 24, 1, 7};
 			}
 			if (width > 45 + sort_len) {
-				out += Mv::to(y, sort_pos - 16) + title_left + (Config::getB("proc_tree") ? Fx::bul : "") + (services ? Theme::c("inactive_fg") : Theme::c("title")) + "tre"
-					+ (services ? "" : Theme::c("hi_fg")) + 'e' + Fx::ubul + title_right;
+				c << Esc::to(y, sort_pos - 16) << title_left << (Config::getB("proc_tree") ? Fx::bul : "") << (services ? Theme::c("inactive_fg") : Theme::c("title")) << "tre"
+					<< (services ? "" : Theme::c("hi_fg")) << 'e' << Fx::ubul << title_right;
 				Input::mouse_mappings["e"] = {y, sort_pos - 15, 1, 4};
 			}
 			if (width > 35 + sort_len) {
-				out += Mv::to(y, sort_pos - 10) + title_left + (Config::getB("proc_services") ? Fx::bul : "") + Theme::c("hi_fg") + 's' + Theme::c("title") + "ervices"
-					+ Fx::ubul + title_right;
+				c << Esc::to(y, sort_pos - 10) << title_left << (Config::getB("proc_services") ? Fx::bul : "") << Theme::c("hi_fg") << 's' << Theme::c("title") << "ervices"
+					<< Fx::ubul << title_right;
 				Input::mouse_mappings["s"] = { y, sort_pos - 9, 1, 4 };
 			}
-			out += Mv::to(y, sort_pos) + title_left + Fx::b + Theme::c("hi_fg") + "< " + Theme::c("title") + sorting + Theme::c("hi_fg")
-				+ " >" + Fx::ub + title_right;
+			c << Esc::to(y, sort_pos) << title_left << Fx::b << Theme::c("hi_fg") << "< " << Theme::c("title") << sorting << Theme::c("hi_fg")
+				<< " >" << Fx::ub << title_right;
 				Input::mouse_mappings["left"] = {y, sort_pos + 1, 1, 2};
 				Input::mouse_mappings["right"] = {y, sort_pos + sort_len + 3, 1, 2};
 
@@ -1370,44 +1492,44 @@ namespace Proc {
 			const string t_color = (selected == 0 ? Theme::c("inactive_fg") : Theme::c("title"));
 			const string hi_color = (selected == 0 ? Theme::c("inactive_fg") : Theme::c("hi_fg"));
 			int mouse_x = x + 14;
-			out += Mv::to(y + height - 1, x + 1) + title_left_down + Fx::b + hi_color + Symbols::up + Theme::c("title") + " select " + down_button + Fx::ub + title_right_down
-				+ title_left_down + Fx::b + t_color + "info " + hi_color + Symbols::enter + Fx::ub + title_right_down;
+			c << Esc::to(y + height - 1, x + 1) << title_left_down << Fx::b << hi_color << Symbols::up << Theme::c("title") << " select " << down_button << Fx::ub << title_right_down
+				<< title_left_down << Fx::b << t_color << "info " << hi_color << Symbols::enter << Fx::ub << title_right_down;
 				if (selected > 0) Input::mouse_mappings["enter"] = {y + height - 1, mouse_x, 1, 6};
 				mouse_x += 8;
 			
 			if (services) {
-				out += title_left_down + Fx::b + t_color + "s" + hi_color + 't' + t_color + "art/s" + hi_color + 't' + t_color + "op" + Fx::ub + title_right_down;
+				c << title_left_down << Fx::b << t_color << "s" << hi_color << 't' << t_color << "art/s" << hi_color << 't' << t_color << "op" << Fx::ub << title_right_down;
 				if (selected > 0) Input::mouse_mappings["t"] = { y + height - 1, mouse_x, 1, 10 };
 				mouse_x += 12;
 			}
 			else {
-				out += title_left_down + Fx::b + hi_color + 't' + t_color + "erminate" + Fx::ub + title_right_down;
+				c << title_left_down << Fx::b << hi_color << 't' << t_color << "erminate" << Fx::ub << title_right_down;
 				if (selected > 0) Input::mouse_mappings["t"] = { y + height - 1, mouse_x, 1, 9 };
 				mouse_x += 11;
 			}
 			
 			/*if (width > 55) {
-				out += title_left_down + Fx::b + hi_color + (vim_keys ? 'K' : 'k') + t_color + "ill" + Fx::ub + title_right_down;
+				c << title_left_down << Fx::b << hi_color << (vim_keys ? 'K' : 'k') << t_color << "ill" << Fx::ub << title_right_down;
 				if (selected > 0) Input::mouse_mappings["k"] = {y + height - 1, mouse_x, 1, 4};
 				mouse_x += 6;
 			}
-			out += title_left_down + Fx::b + hi_color + 's' + t_color + "ignals" + Fx::ub + title_right_down;
+			c << title_left_down << Fx::b << hi_color << 's' << t_color << "ignals" << Fx::ub << title_right_down;
 			if (selected > 0) Input::mouse_mappings["s"] = {y + height - 1, mouse_x, 1, 7};*/
 
 			//? Labels for fields in list
 			if (not proc_tree)
-				out += Mv::to(y+1, x+1) + Theme::c("title") + Fx::b
-					+ (is_in(sorting, "pid", "service") ? Fx::ul : "") + rjust((services ? "Service:" : "Pid:"), 8) + (services ? "" : Fx::uul) + ' '
-					+ (is_in(sorting, "name", "service") ? Fx::ul : "") + ljust((services ? "" : "Program:"), prog_size) + Fx::uul + ' '
-					+ (cmd_size > 0 ? (is_in(sorting, "command", "caption") ? Fx::ul : "") + ljust((services ? "Caption:" : "Command:"), cmd_size) + Fx::uul : "") + ' ';
+				c << Esc::to(y+1, x+1) << Theme::c("title") << Fx::b
+					<< (is_in(sorting, "pid", "service") ? Fx::ul : "") << rjust((services ? "Service:" : "Pid:"), 8) << (services ? "" : Fx::uul) << ' '
+					<< (is_in(sorting, "name", "service") ? Fx::ul : "") << ljust((services ? "" : "Program:"), prog_size) << Fx::uul << ' '
+					<< (cmd_size > 0 ? (is_in(sorting, "command", "caption") ? Fx::ul : "") + ljust((services ? "Caption:" : "Command:"), cmd_size) + Fx::uul : "") << ' ';
 			else
-				out += Mv::to(y+1, x+1) + Theme::c("title") + Fx::b
-					+ (is_in(sorting, "pid", "name", "command") ? Fx::ul : "") + ljust("Tree:", tree_size) + Fx::uul + ' ';
+				c << Esc::to(y+1, x+1) << Theme::c("title") << Fx::b
+					<< (is_in(sorting, "pid", "name", "command") ? Fx::ul : "") << ljust("Tree:", tree_size) << Fx::uul << ' ';
 
-			out += (thread_size > 0 ? Mv::l(4) + (sorting == "threads" ? Fx::ul : "") + "Threads: " + Fx::uul : "")
-					+ (is_in(sorting, "user", "status") ? Fx::ul : "") + ljust((services ? "Status:" : "User:"), user_size) + Fx::uul + ' '
-					+ (sorting == "memory" ? Fx::ul : "") + rjust((mem_bytes ? "MemB" : "Mem%"), 5) + Fx::uul + ' '
-					+ (sorting.starts_with("cpu") ? Fx::ul : "") + rjust("Cpu%", 10) + Fx::uul + Fx::ub;
+			c << (thread_size > 0 ? Mv::l(4) + (sorting == "threads" ? Fx::ul : "") + "Threads: " + Fx::uul : "")
+					<< (is_in(sorting, "user", "status") ? Fx::ul : "") << ljust((services ? "Status:" : "User:"), user_size) << Fx::uul << ' '
+					<< (sorting == "memory" ? Fx::ul : "") << rjust((mem_bytes ? "MemB" : "Mem%"), 5) << Fx::uul << ' '
+					<< (sorting.starts_with("cpu") ? Fx::ul : "") << rjust("Cpu%", 10) << Fx::uul << Fx::ub;
 		}
 		//* End of redraw block
 
@@ -1423,30 +1545,30 @@ namespace Proc {
 				cpu_str.resize((detailed.entry.cpu_p < 10 or detailed.entry.cpu_p >= 100 ? 3 : 4));
 				cpu_str += '%';
 			}
-			out += Mv::to(d_y + 1, dgraph_x + 1) + Fx::ub + detailed_cpu_graph(detailed.cpu_percent, (redraw or data_same or not alive))
-				+ Mv::to(d_y + 1, dgraph_x + 1) + Theme::c("title") + Fx::b + cpu_str;
+			w << Esc::to(d_y + 1, dgraph_x + 1) << Fx::ub << detailed_cpu_graph(detailed.cpu_percent, (redraw or data_same or not alive))
+				<< Esc::to(d_y + 1, dgraph_x + 1) << Theme::c("title") << Fx::b << cpu_str;
 			for (int i = 0; const auto& l : {'C', 'P', 'U'})
-					out += Mv::to(d_y + 3 + i++, dgraph_x + 1) + l;
+					w << Esc::to(d_y + 3 + i++, dgraph_x + 1) << l;
 
 			//? Info part of box
 			const string stat_color = (not alive ? Theme::c("inactive_fg") : (detailed.status == "Running" ? Theme::c("proc_misc") : Theme::c("main_fg")));
-			out += Mv::to(d_y + 2, d_x + 1) + stat_color + Fx::ub
-									+ cjust(detailed.status, item_width) + Theme::c("main_fg")
-									+ cjust(detailed.elapsed, item_width);
-			if (item_fit >= 3) out += cjust(detailed.io_read, item_width);
-			if (item_fit >= 4) out += cjust(detailed.io_write, item_width);
-			if (item_fit >= 5) out += cjust((services ? detailed.start : detailed.parent), item_width, true);
-			if (item_fit >= 6) out += cjust((services ? detailed.owner : detailed.entry.user), item_width, true);
-			if (item_fit >= 7) out += cjust(to_string(detailed.entry.threads), item_width);
+			w << Esc::to(d_y + 2, d_x + 1) << stat_color << Fx::ub
+									<< cjust(detailed.status, item_width) << Theme::c("main_fg")
+									<< cjust(detailed.elapsed, item_width);
+			if (item_fit >= 3) w << cjust(detailed.io_read, item_width);
+			if (item_fit >= 4) w << cjust(detailed.io_write, item_width);
+			if (item_fit >= 5) w << cjust((services ? detailed.start : detailed.parent), item_width, true);
+			if (item_fit >= 6) w << cjust((services ? detailed.owner : detailed.entry.text->user), item_width, true);
+			if (item_fit >= 7) w << cjust(to_string(detailed.entry.threads), item_width);
 
 
 			const double mem_p = detailed.mem_percent;
 			string mem_str = to_string(mem_p);
 			mem_str.resize((mem_p < 10 or mem_p >= 100 ? 3 : 4));
-			out += Mv::to(d_y + 4, d_x + 1) + Theme::c("title") + Fx::b + rjust((item_fit > 4 ? "Memory: " : "M:") + mem_str + "% ", (d_width / 3) - 2)
-				+ Theme::c("inactive_fg") + Fx::ub + graph_bg * (d_width / 3) + Mv::l(d_width / 3)
-				+ Theme::c("proc_misc") + detailed_mem_graph(detailed.mem_bytes, (redraw or data_same or not alive)) + ' '
-				+ Theme::c("title") + Fx::b + detailed.memory;
+			w << Esc::to(d_y + 4, d_x + 1) << Theme::c("title") << Fx::b << rjust((item_fit > 4 ? "Memory: " : "M:") + mem_str + "% ", (d_width / 3) - 2)
+				<< Theme::c("inactive_fg") << Fx::ub << Esc::repeat(graph_bg, d_width / 3) << Esc::l(d_width / 3)
+				<< Theme::c("proc_misc") << detailed_mem_graph(detailed.mem_bytes, (redraw or data_same or not alive)) << ' '
+				<< Theme::c("title") << Fx::b << detailed.memory;
 		}
 
 		//? Check bounds of current selection and view
@@ -1461,92 +1583,22 @@ namespace Proc {
 
 		//* Iteration over processes
 		int lc = 0;
-		for (int n=0; auto& p : plist) {
-			if (p.filtered or (proc_tree and p.tree_index == plist.size()) or n++ < start) continue;
+		p_graphs.next();
+		for (int n=0; const auto pos : Proc::display_order) {
+			if (pos >= plist.size()) continue;
+			const auto& p = plist[pos];
+			if (p.filtered or n++ < start) continue;
+			const auto& p_text = *p.text;
 			bool is_selected = (lc + 1 == selected);
 			
 			if (is_selected) {
 				selected_pid = (int)p.pid;
 				selected_name = p.name;
 				selected_depth = p.depth;
-				if (services) selected_status = p.user;
-			}
-
-			//? Update graphs for processes with above 0.0% cpu usage, delete if below 0.1% 10x times
-			const bool has_graph = p_counters.contains(p.pid);
-			if ((p.cpu_p > 0 and not has_graph) or (not data_same and has_graph)) {
-				if (not has_graph) {
-					p_graphs[p.pid] = Draw::Graph{5, 1, "", {}, graph_symbol};
-					p_counters[p.pid] = 0;
-				}
-				else if (p.cpu_p < 0.1 and ++p_counters[p.pid] >= 10) {
-					p_graphs.erase(p.pid);
-					p_counters.erase(p.pid);
-				}
-				else
-					p_counters.at(p.pid) = 0;
+				if (services) selected_status = p_text.user;
 			}
 
-			out += Fx::reset;
-
-			//? Set correct gradient colors if enabled
-			string c_color, m_color, t_color, g_color, end;
-			if (is_selected) {
-				c_color = m_color = t_color = g_color = Fx::b;
-				end = Fx::ub;
-				out += Theme::c("selected_bg") + Theme::c("selected_fg") + Fx::b;
-			}
-			else {
-				int calc = (selected > lc) ? selected - lc : lc - selected;
-				if (proc_colors) {
-					end = Theme::c("main_fg") + Fx::ub;
-					array<string, 3> colors;
-					for (int i = 0; int v : {(int)round(p.cpu_p), (int)round(p.mem * 100 / Mem::totalMem), (int)p.threads / 3}) {
-						if (proc_gradient) {
-							int val = (min(v, 100) + 100) - calc * 100 / select_max;
-							if (val < 100) colors[i++] = Theme::g("proc_color").at(max(0, val));
-							else colors[i++] = Theme::g("process").at(clamp(val - 100, 0, 100));
-						}
-						else
-							colors[i++] = Theme::g("process").at(clamp(v, 0, 100));
-					}
-					c_color = colors.at(0); m_color = colors.at(1); t_color = colors.at(2);
-				}
-				else {
-					c_color = m_color = t_color = Fx::b;
-					end = Fx::ub;
-				}
-				if (proc_gradient) {
-					g_color = Theme::g("proc").at(clamp(calc * 100 / select_max, 0, 100));
-				}
-			}
-
-			if (not p_wide_cmd.contains(p.pid)) p_wide_cmd[p.pid] = ulen(p.cmd) != ulen(p.cmd, true);
-
-			//? Normal view line
-			if (not proc_tree) {
-				out += Mv::to(y+2+lc, x+1)
-					+ (services ? "" : g_color + rjust(to_string(p.pid), 8) + ' ')
-					+ c_color + ljust(p.name, prog_size + (services ? 9 : 0), true) + ' ' + end
-					+ (cmd_size > 0 ? g_color + ljust(p.cmd, cmd_size, true, p_wide_cmd[p.pid]) + Mv::to(y+2+lc, x+11+prog_size+cmd_size) + ' ' : "");
-			}
-			//? Tree view line
-			else {
-				const string prefix_pid = p.prefix + to_string(p.pid);
-				int width_left = tree_size;
-				out += Mv::to(y+2+lc, x+1) + g_color + uresize(prefix_pid, width_left) + ' ';
-				width_left -= ulen(prefix_pid);
-				if (width_left > 0) {
-					out += c_color + uresize(p.name, width_left - 1) + end + ' ';
-					width_left -= (ulen(p.name) + 1);
-				}
-				if (width_left > 7 and p.short_cmd != p.name) {
-					out += g_color + '(' + uresize(p.short_cmd, width_left - 3, p_wide_cmd[p.pid]) + ") ";
-					width_left -= (ulen(p.short_cmd, true) + 3);
-				}
-				out += string(max(0, width_left), ' ') + Mv::to(y+2+lc, x+2+tree_size);
-			}
-			//? Common end of line
+			//? Values shown at the end of the line, formatted here since they are part of the row key
 			string cpu_str = to_string(p.cpu_p);
 			if (p.cpu_p < 10 or (p.cpu_p >= 100 and p.cpu_p < 1000)) cpu_str.resize(3);
 			else if (p.cpu_p >= 10'000) {
@@ -1555,7 +1607,7 @@ namespace Proc {
 				if (cpu_str.ends_with('.')) cpu_str.pop_back();
 				cpu_str += "k";
 			}
-			string mem_str = (mem_bytes ? floating_humanizer(p.mem, true) : "");
+			string mem_str;
 			if (not mem_bytes) {
 				double mem_p = clamp((double)p.mem * 100 / Mem::totalMem, 0.0, 100.0);
 				mem_str = to_string(mem_p);
@@ -1563,54 +1615,179 @@ namespace Proc {
 				else mem_str.resize((mem_p < 10 or mem_p >= 100 ? 3 : 4));
 				mem_str += '%';
 			}
-			out += (thread_size > 0 ? t_color + rjust(to_string(min(p.threads, (size_t)9999)), thread_size) + ' ' + end : "" )
-				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size, true) + ' '
-				+ m_color + rjust(mem_str, 5) + end + ' '
-				+ (is_selected ? "" : Theme::c("inactive_fg")) + graph_bg * 5
-				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)({(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
-				+ c_color + rjust(cpu_str, 4) + "  " + end;
+			const long long graph_value = (p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p));
+			//? Lines are cached by pid, services by name since many of them share the pid of their host process or have none
+			const size_t row_id = (services ? robin_hood::hash_bytes(p.name.data(), p.name.size()) : p.pid);
+			const string* graph = p_graphs(row_id, p.cpu_p, graph_value, data_same, graph_symbol);
+			const int calc = abs(selected - lc);
+			const array<int, 3> color_values = {(int)round(p.cpu_p), (int)round(p.mem * 100 / Mem::totalMem), (int)p.threads / 3};
+
+			//? Keys of everything the start and the end of the line are made from, so changing values only rewrite the end of the line.
+			//? Column widths and theme only change on redraw which clears the cache
+			uint64_t head_key = robin_hood::hash_int(row_id), tail_key = head_key;
+			const auto add_key = [](uint64_t& key, const uint64_t value) { key = robin_hood::hash_int(key ^ (value + 0x9e3779b97f4a7c15ull)); };
+			const auto add_text = [&](uint64_t& key, const string& text) { add_key(key, robin_hood::hash_bytes(text.data(), text.size())); };
+			for (auto* key : {&head_key, &tail_key}) {
+				add_key(*key, is_selected | (proc_tree << 1) | (services << 2) | (proc_colors << 3) | (proc_gradient << 4) | (mem_bytes << 5));
+				add_key(*key, proc_gradient ? (calc << 16) | select_max : 0);
+			}
+			add_key(head_key, p.pid);
+			add_text(head_key, p.name);
+			add_text(head_key, p_text.cmd);
+			if (proc_tree) {
+				add_text(head_key, p_text.prefix);
+				add_text(head_key, p_text.short_cmd);
+			}
+			if (proc_colors) {
+				add_key(head_key, color_values[0]);
+				for (const int v : color_values) add_key(tail_key, v);
+			}
+			add_key(tail_key, p.threads);
+			if (mem_bytes) add_key(tail_key, p.mem);
+			else add_text(tail_key, mem_str);
+			add_text(tail_key, cpu_str);
+			add_text(tail_key, p_text.user);
+			if (graph != nullptr) add_text(tail_key, *graph);
+
+			auto& row = p_rows[row_id];
+			row.sweep = sweeps;
+			const bool new_head = (row.head.empty() or row.head_key != head_key);
+			const bool new_tail = (row.tail.empty() or row.tail_key != tail_key);
+			if (new_head or new_tail) {
+				//? Set correct gradient colors if enabled, the colors are views of the theme strings so remaking a line doesn't copy them
+				std::string_view c_color, m_color, t_color, g_color, end;
+				if (is_selected) {
+					c_color = m_color = t_color = g_color = Fx::b;
+					end = Fx::ub;
+				}
+				else {
+					if (proc_colors) {
+						end = p_colors_end;
+						array<std::string_view, 3> colors;
+						for (int i = 0; int v : color_values) {
+							if (proc_gradient) {
+								int val = (min(v, 100) + 100) - calc * 100 / select_max;
+								if (val < 100) colors[i++] = Theme::g("proc_color").at(max(0, val));
+								else colors[i++] = Theme::g("process").at(clamp(val - 100, 0, 100));
+							}
+							else
+								colors[i++] = Theme::g("process").at(clamp(v, 0, 100));
+						}
+						c_color = colors.at(0); m_color = colors.at(1); t_color = colors.at(2);
+					}
+					else {
+						c_color = m_color = t_color = Fx::b;
+						end = Fx::ub;
+					}
+					if (proc_gradient) {
+						g_color = Theme::g("proc").at(clamp(calc * 100 / select_max, 0, 100));
+					}
+				}
+
+				if (new_head) {
+					row.head_key = head_key;
+					row.head.clear();
+					row.head.reserve(width * 2);
+					Esc::writer h(row.head);
+					h << Fx::reset;
+					if (is_selected) h << Theme::c("selected_bg") << Theme::c("selected_fg") << Fx::b;
+
+					if (not p_wide_cmd.contains(row_id)) p_wide_cmd[row_id] = ulen(p_text.cmd) != ulen(p_text.cmd, true);
+
+					//? Normal view line
+					if (not proc_tree) {
+						if (not services) h << g_color << Esc::rjust(p.pid, 8) << ' ';
+						h << c_color << Esc::ljust(p.name, prog_size + (services ? 9 : 0), true) << ' ' << end;
+						if (cmd_size > 0) {
+							if (p_wide_cmd[row_id]) h << g_color << ljust(p_text.cmd, cmd_size, true, true);
+							else h << g_color << Esc::ljust(p_text.cmd, cmd_size, true);
+							row.tail_col = x + 11 + prog_size + cmd_size;
+						}
+						else row.tail_col = 0;
+					}
+					//? Tree view line
+					else {
+						const string prefix_pid = p_text.prefix + to_string(p.pid);
+						int width_left = tree_size;
+						h << g_color << Esc::uresize(prefix_pid, width_left) << ' ';
+						width_left -= ulen(prefix_pid);
+						if (width_left > 0) {
+							h << c_color << Esc::uresize(p.name, width_left - 1) << end << ' ';
+							width_left -= (ulen(p.name) + 1);
+						}
+						if (width_left > 7 and p_text.short_cmd != p.name) {
+							h << g_color << '(' << uresize(p_text.short_cmd, width_left - 3, p_wide_cmd[row_id]) << ") ";
+							width_left -= (ulen(p_text.short_cmd, true) + 3);
+						}
+						h << Esc::repeat(" ", max(0, width_left));
+						row.tail_col = x + 2 + tree_size;
+					}
+				}
+
+				//? Common end of line
+				if (new_tail) {
+					row.tail_key = tail_key;
+					row.tail.clear();
+					row.tail.reserve(256);
+					Esc::writer t(row.tail);
+					if (not proc_tree and cmd_size > 0) t << ' ';
+					if (thread_size > 0) t << t_color << Esc::rjust(min(p.threads, (size_t)9999), thread_size) << ' ' << end;
+					if (cmp_greater(p_text.user.size(), user_size)) t << g_color << Esc::ljust(p_text.user.substr(0, user_size - 1) + '+', user_size, true) << ' ';
+					else t << g_color << Esc::ljust(p_text.user, user_size, true) << ' ';
+					if (mem_bytes) t << m_color << Esc::rjust(humanized(p.mem, true), 5) << end << ' ';
+					else t << m_color << Esc::rjust(mem_str, 5) << end << ' ';
+					if (not is_selected) t << Theme::c("inactive_fg");
+					t << Esc::repeat(graph_bg, 5);
+					if (graph != nullptr) t << Esc::l(5) << c_color << *graph;
+					t << end << ' ' << c_color << Esc::rjust(cpu_str, 4) << "  " << end;
+				}
+			}
+
+			w << Esc::to(y+2+lc, x+1) << row.head;
+			if (row.tail_col > 0) w << Esc::to(y+2+lc, row.tail_col);
+			w << row.tail;
 			if (lc++ > height - 5) break;
 		}
 
-		out += Fx::reset;
-		while (lc++ < height - 5) out += Mv::to(y+lc+1, x+1) + string(width - 2, ' ');
+		w << Fx::reset;
+		while (lc++ < height - 5) w << Esc::to(y+lc+1, x+1) << Esc::repeat(" ", width - 2);
 
 		//? Draw scrollbar if needed
 		if (numpids > select_max) {
 			const int scroll_pos = clamp((int)round((double)start * select_max / (numpids - select_max)), 0, height - 5);
-			out += Mv::to(y + 1, x + width - 2) + Fx::b + Theme::c("main_fg") + Symbols::up
-				+ Mv::to(y + height - 2, x + width - 2) + Symbols::down
-				+ Mv::to(y + 2 + scroll_pos, x + width - 2) + "█";
+			w << Esc::to(y + 1, x + width - 2) << Fx::b << Theme::c("main_fg") << Symbols::up
+				<< Esc::to(y + height - 2, x + width - 2) << Symbols::down
+				<< Esc::to(y + 2 + scroll_pos, x + width - 2) << "█";
 		}
 
 		//? Current selection and number of processes
 		string location = to_string(start + selected) + '/' + to_string(numpids);
 		string loc_clear = Symbols::h_line * max((size_t)0, 9 - location.size());
-		out += Mv::to(y + height - 1, x+width - 3 - max(9, (int)location.size())) + Fx::ub + Theme::c("proc_box") + loc_clear
-			+ Symbols::title_left_down + Theme::c("title") + Fx::b + location + Fx::ub + Theme::c("proc_box") + Symbols::title_right_down;
+		w << Esc::to(y + height - 1, x+width - 3 - max(9, (int)location.size())) << Fx::ub << Theme::c("proc_box") << loc_clear
+			<< Symbols::title_left_down << Theme::c("title") << Fx::b << location << Fx::ub << Theme::c("proc_box") << Symbols::title_right_down;
 
-		//? Clear out left over graphs from dead processes at a regular interval
+		//? Clear out cached lines of processes that died or scrolled out of view at a regular interval, a line is kept if it was
+		//? drawn since the last sweep
 		if (not data_same and ++counter >= 100) {
 			counter = 0;
-			for (auto element = p_graphs.begin(); element != p_graphs.end();) {
-				if (rng::find(plist, element->first, &proc_info::pid) == plist.end()) {
-					element = p_graphs.erase(element);
-					p_counters.erase(element->first);
+			for (auto element = p_rows.begin(); element != p_rows.end();) {
+				if (element->second.sweep != sweeps) {
+					element = p_rows.erase(element);
 				}
 				else
 					++element;
 			}
-			p_graphs.compact();
-			p_counters.compact();
+			p_rows.compact();
 
 			for (auto element = p_wide_cmd.begin(); element != p_wide_cmd.end();) {
-				if (rng::find(plist, element->first, &proc_info::pid) == plist.end()) {
+				if (not p_rows.contains(element->first)) {
 					element = p_wide_cmd.erase(element);
 				}
 				else
 					++element;
 			}
 			p_wide_cmd.compact();
+			sweeps++;
 		}
 
 		if (selected == 0 and (selected_pid != 0 or not selected_name.empty())) {
@@ -1619,7 +1796,8 @@ namespace Proc {
 			selected_status.clear();
 		}
 		redraw = false;
-		return out + Fx::reset;
+		w << Fx::reset;
+		return {chrome, out};
 	}
 
 }
@@ -1627,7 +1805,7 @@ namespace Proc {
 namespace Draw {
 	void calcSizes() {
 		atomic_wait(Runner::active);
-		Config::unlock();
+		Config::publish();
 		auto& boxes = Config::getS("shown_boxes");
 		auto& cpu_bottom = Config::getB("cpu_bottom");
 		auto& mem_below_net = Config::getB("mem_below_net");
@@ -1641,8 +1819,6 @@ namespace Draw {
 		Global::overlay.clear();
 		Runner::pause_output = false;
 		Runner::redraw = true;
-		Proc::p_counters.clear();
-		Proc::p_graphs.clear();
 		if (Menu::active) Menu::redraw = true;
 
 		Input::mouse_mappings.clear();
@@ -1786,6 +1962,7 @@ namespace Draw {
 			x = proc_left ? 1 : Term::width - width + 1;
 			y = (cpu_bottom and Cpu::shown) ? 1 : Cpu::height + 1;
 			select_max = height - 3;
+			p_graphs.reset(select_max * 2);
 			box = createBox(x, y, width, height, Theme::c("proc_box"), true, "proc", "", 4);
 		}
 	}
@@ -22,9 +22,10 @@ tab-size = 4
 #include <vector>
 #include <array>
 #include <robin_hood.h>
-#include <deque>
+#include <span>
+#include <cstdint>
 
-using std::string, std::array, std::vector, robin_hood::unordered_flat_map, std::deque;
+using std::string, std::array, std::vector, robin_hood::unordered_flat_map, std::span;
 
 namespace Symbols {
 	const string h_line				= "─";
@@ -82,37 +83,51 @@ namespace Draw {
 	//* Class holding a percentage meter
 	class Meter {
 		int width;
-		string color_gradient;
+		const array<string, 101>* gradient = nullptr;
 		bool invert;
 		array<string, 101> cache;
 	public:
 		Meter();
 		Meter(const int width, const string& color_gradient, const bool invert = false);
 
-		//* Return a string representation of the meter with given value
-		string operator()(int value);
+		//* Return a string representation of the meter with given value, cached until the meter is recreated
+		const string& operator()(int value);
 	};
 
 	//* Class holding a percentage graph
 	class Graph {
 		int width, height;
-		string color_gradient;
+		const array<string, 101>* gradient = nullptr;
 		string out, symbol = "default";
 		bool invert, no_zero;
 		long long offset;
 		long long last = 0, max_value = 0;
 		bool current = true, tty_mode = false;
-		unordered_flat_map<bool, vector<string>> graphs = { {true, {}}, {false, {}}};
 
-		//* Create two representations of the graph to switch between to represent two values for each braille character
-		void _create(const deque<long long>& data, int data_offset);
+		//? Glyph index and gradient color for each row and column, <blank> for empty space
+		static constexpr uint8_t blank = 255;
+		struct cell { uint8_t glyph = blank, color = 0; };
+
+		//? Two representations of <height> rows by <width> columns, each row is a ring starting at the oldest column in <head>
+		array<vector<cell>, 2> cells;
+		array<int, 2> head = {0, 0};
+		const vector<string>* symbols = nullptr;
+
+		//? Braille dot level 0-4 for each row and value 0-100, built once from the row thresholds in the constructor
+		vector<uint8_t> levels;
+
+		//* Add columns for values in <data> from <data_offset> to the two representations to switch between to represent two values for each braille character
+		void _create(span<const long long> data, int data_offset);
+
+		//* Build output string from the current representation
+		void _render();
 
 	public:
 		Graph();
 		Graph(	int width,
 				int height,
 				const string& color_gradient,
-				const deque<long long>& data,
+				span<const long long> data,
 				const string& symbol="default",
 				bool invert=false,
 				bool no_zero=false,
@@ -120,7 +135,7 @@ namespace Draw {
 				long long offset=0);
 
 		//* Add last value from back of <data> and return string representation of graph
-		string& operator()(const deque<long long>& data, const bool data_same=false);
+		string& operator()(span<const long long> data, const bool data_same=false);
 
 		//* Return string representation of graph
 		string& operator()();
@@ -132,6 +147,30 @@ namespace Draw {
 
 namespace Proc {
 	extern Draw::TextEdit filter;
-	extern unordered_flat_map<size_t, Draw::Graph> p_graphs;
-	extern unordered_flat_map<size_t, int> p_counters;
+
+	//* Fixed number of cpu mini graphs shared by the processes in the list, a process gets a graph when it shows cpu usage while in view
+	//* and keeps it until it has been idle for 10 updates, or until all graphs are taken and its graph is the least recently shown
+	class graph_pool {
+		struct slot {
+			size_t pid = 0;
+			uint64_t shown = 0;
+			int idle = 0;
+			bool used = false;
+		};
+		vector<Draw::Graph> graphs;
+		vector<slot> slots;
+		unordered_flat_map<size_t, uint32_t> index;
+		uint64_t tick = 0;
+	public:
+		//* Drop all graphs and set the number of graphs to <size>
+		void reset(const size_t size);
+
+		//* Start a new pass over the processes in view, graphs not shown after this are the first to be taken
+		void next() { ++tick; }
+
+		//* Add <value> to the graph for <pid> and return it, nullptr if the process has no graph and <cpu_p> is 0 or no graph could be taken
+		const string* operator()(const size_t pid, const double cpu_p, const long long value, const bool data_same, const string& symbol);
+	};
+
+	extern graph_pool p_graphs;
 }
\ No newline at end of file
@@ -508,13 +508,13 @@ namespace Input {
 				else if (key == "z") {
 					atomic_wait(Runner::active);
 					auto& ndev = Net::current_net.at(Net::selected_iface);
-					if (ndev.stat.at("download").offset + ndev.stat.at("upload").offset > 0) {
-						ndev.stat.at("download").offset = 0;
-						ndev.stat.at("upload").offset = 0;
+					if (ndev.stat[Net::NDdownload].offset + ndev.stat[Net::NDupload].offset > 0) {
+						ndev.stat[Net::NDdownload].offset = 0;
+						ndev.stat[Net::NDupload].offset = 0;
 					}
 					else {
-						ndev.stat.at("download").offset = ndev.stat.at("download").last + ndev.stat.at("download").rollover;
-						ndev.stat.at("upload").offset = ndev.stat.at("upload").last + ndev.stat.at("upload").rollover;
+						ndev.stat[Net::NDdownload].offset = ndev.stat[Net::NDdownload].last + ndev.stat[Net::NDdownload].rollover;
+						ndev.stat[Net::NDupload].offset = ndev.stat[Net::NDupload].last + ndev.stat[Net::NDupload].rollover;
 					}
 					no_update = false;
 				}
@@ -248,6 +248,33 @@ namespace Menu {
 				"",
 				"Min value: 100 ms",
 				"Max value: 86400000 ms = 24 hours."},
+			{"adaptive_update",
+				"Stretch the update time when idle.",
+				"",
+				"Update time grows towards adaptive_max_ms",
+				"while cpu and memory usage is stable, no",
+				"keys are pressed and no websocket client",
+				"is connected.",
+				"",
+				"Snaps back to update_ms on any activity.",
+				"",
+				"True or False."},
+			{"adaptive_max_ms",
+				"Max update time for adaptive updates.",
+				"",
+				"Only used if adaptive_update is True.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
+			{"adaptive_threshold",
+				"Activity threshold for adaptive updates.",
+				"",
+				"Change in cpu or memory usage in percent",
+				"between two updates that snaps the update",
+				"time back to update_ms.",
+				"",
+				"Min value: 1",
+				"Max value: 100"},
 			{"rounded_corners",
 				"Rounded corners on boxes.",
 				"",
@@ -1187,7 +1214,7 @@ namespace Menu {
 		else if (is_in(key, "left", "right") or (vim_keys and is_in(key, "h", "l"))) {
 			const auto& option = categories[selected_cat][item_height * page + selected][0];
 			if (selPred.test(isInt)) {
-				const int mod = (option == "update_ms" ? 100 : 1);
+				const int mod = (is_in(option, "update_ms", "adaptive_max_ms") ? 100 : 1);
 				long value = Config::getI(option);
 				if (key == "right" or (vim_keys and key == "l")) value += mod;
 				else value -= mod;
@@ -1244,7 +1271,7 @@ namespace Menu {
 
 		//? Draw the menu
 		if (retval == Changed) {
-			Config::unlock();
+			Config::publish();
 			auto& out = Global::overlay;
 			out = bg;
 			item_height = min((int)categories[selected_cat].size(), (int)floor((double)(height - 4) / 2));
@@ -1260,9 +1287,9 @@ namespace Menu {
 				selPred.reset();
 				last_sel = (selected_cat << 8) + selected;
 				const auto& selOption = categories[selected_cat][item_height * page + selected][0];
-				if (Config::ints.contains(selOption))
+				if (Config::int_key::contains(selOption))
 					selPred.set(isInt);
-				else if (Config::bools.contains(selOption))
+				else if (Config::bool_key::contains(selOption))
 					selPred.set(isBool);
 				else
 					selPred.set(isString);
@@ -0,0 +1,767 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <ranges>
+#include <cmath>
+
+#include <btop_shared.hpp>
+#include <btop_config.hpp>
+#include <btop_tools.hpp>
+#include <btop_backend.hpp>
+
+using std::round, std::max, std::min, std::clamp, std::cmp_less;
+namespace rng = std::ranges;
+using namespace Tools;
+
+//? Platform independent parts of Cpu::collect() and Proc::collect(), everything here works on Backend samples or
+//? already collected proc_info records so it builds and runs without Win32
+
+namespace Shared {
+	long coreCount;
+}
+
+namespace Cpu {
+	const array<string, CFcount> field_names = { "total", "kernel", "user", "dpc", "interrupt", "idle", "gpu" };
+
+	Fields field_index(const string& name) {
+		const auto it = rng::find(field_names, name);
+		return (it == field_names.end() ? CFtotal : static_cast<Fields>(it - field_names.begin()));
+	}
+
+	//? Last summed times for each core and for each field, cpu_old[CFtotal] holds the sum of all fields
+	vector<long long> core_old_totals;
+	vector<long long> core_old_idles;
+	array<long long, CFcount> cpu_old = {};
+
+	void apply_sample(cpu_info& cpu, const Backend::cpu_sample& sample) {
+		if (cmp_less(core_old_totals.size(), Shared::coreCount)) {
+			core_old_totals.resize(Shared::coreCount, 0);
+			core_old_idles.resize(Shared::coreCount, 0);
+		}
+		if (cmp_less(cpu.core_percent.size(), Shared::coreCount)) cpu.core_percent.resize(Shared::coreCount);
+
+		//? Usage for each core, the time fields are summed over all cores in the same pass
+		array<uint64_t, CFcount> times = {};
+		long long cpu_total = 0;
+		for (int i = 0; i < Shared::coreCount; i++) {
+			const auto& core = sample.cores[i];
+			times[CFkernel] += core.kernel;
+			times[CFuser] += core.user;
+			times[CFdpc] += core.dpc;
+			times[CFinterrupt] += core.interrupt;
+			times[CFidle] += core.idle;
+
+			const long long totals = core.kernel + core.user + core.dpc + core.interrupt + core.idle;
+			const long long calc_totals = max(1ll, totals - core_old_totals[i]);
+			const long long calc_idles = max(0ll, (long long)core.idle - core_old_idles[i]);
+			core_old_totals[i] = totals;
+			core_old_idles[i] = core.idle;
+
+			cpu.core_percent[i].push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+			cpu_total += cpu.core_percent[i].back();
+
+			//? Reduce size if there are more values than needed for graph
+			cpu.core_percent[i].trim(40);
+		}
+
+		//? Usage accumulated for total cpu usage
+		const long long totals = times[CFkernel] + times[CFuser] + times[CFdpc] + times[CFinterrupt] + times[CFidle];
+		const long long calc_totals = max(1ll, totals - cpu_old[CFtotal]);
+		cpu_old[CFtotal] = totals;
+
+		//? Total usage of cpu
+		cpu.cpu_percent[CFtotal].push_back(clamp(cpu_total / Shared::coreCount, 0ll, 100ll));
+
+		//? Reduce size if there are more values than needed for graph
+		cpu.cpu_percent[CFtotal].trim(width * 2);
+
+		//? Populate cpu.cpu_percent with all fields from stat
+		for (int field = CFkernel; field <= CFidle; field++) {
+			cpu.cpu_percent[field].push_back(clamp((long long)round((double)((long long)times[field] - cpu_old[field]) * 100 / calc_totals), 0ll, 100ll));
+			cpu_old[field] = times[field];
+
+			//? Reduce size if there are more values than needed for graph
+			cpu.cpu_percent[field].trim(width * 2);
+		}
+	}
+}
+
+namespace Mem {
+	const array<string, MScount> stat_names = { "total", "used", "available", "commit", "commit_total", "cached", "page_total", "page_used", "page_free", "gpu_total", "gpu_used", "gpu_free" };
+}
+
+namespace Net {
+	const array<string, NDcount> dir_names = { "download", "upload" };
+}
+
+namespace Proc {
+	//? Positions in the vector returned by collect() by pid, records only move when dead entries are cleared
+	unordered_flat_map<size_t, size_t> proc_index;
+
+	//? Sorting and the tree view permute this instead of the records
+	vector<size_t> display_order;
+
+	//? Last filter applied to the flat list, a filter containing it only has to search the processes that matched it
+	string narrow_filter;
+	bool narrow_services = false;
+
+	uint64_t cputimes = 0, old_cputimes = 0;
+	int collapse = -1, expand = -1;
+	atomic<int> numpids = 0;
+	int filter_found = 0;
+
+	//? Pid, parent and creation time of the process at every position when the tree was built, a process that appears, dies, changes
+	//? parent or reuses a pid changes the tree
+	struct tree_node {
+		size_t pid, parent;
+		uint64_t created;
+	};
+	vector<tree_node> tree_nodes;
+
+	//? The tree by position, rebuilt when it changes: parent of every process (npos for roots), roots and where the children of every
+	//? process start in tree_children. Roots and children stay in sorted order until the order can have changed
+	constexpr size_t npos = (size_t)-1;
+	vector<size_t> tree_parent_pos, tree_roots, tree_offsets, tree_children;
+
+	//? Flags of every process by position kept together, visited is 1 after the filter pass and 2 after the flatten pass
+	struct tree_flags {
+		char visited = 0;
+		bool hidden = false, last = false, root = false;
+	};
+	vector<tree_flags> tree_state;
+
+	//? Number of shown rows every process heads in display_order, itself and its shown descendants, set by tree_flatten()
+	vector<size_t> tree_rows;
+	vector<size_t> sort_rank;
+
+	//? Summed values of the hidden children of every shown collapsed process at <pos>, and the values each hidden child at <pos> was last
+	//? counted with in collapsed_sums[<owner>]. Positions stay valid until a process dies, which rebuilds both
+	struct tree_totals {
+		size_t pos, owner;
+		double cpu_p = 0.0, cpu_c = 0.0;
+		uint64_t mem = 0;
+		size_t threads = 0;
+	};
+	vector<tree_totals> collapsed_sums, collapsed_counted;
+	bool collapsed_added = false;
+	bool tree_built = false;
+
+	//? Precomputed sort key, value holds the numeric field or the collation prefix of a string field
+	struct sort_entry {
+		double value;
+		uint64_t prefix;
+		uint32_t pos;
+		bool filtered;
+	};
+
+	//* Pack the first 8 bytes of <str> big-endian, comparing two keys gives the same result as comparing the strings unless they share the prefix
+	uint64_t collate_key(const string& str) {
+		uint64_t key = 0;
+		for (size_t i = 0; i < 8; i++) key = (key << 8) | (i < str.size() ? (unsigned char)str[i] : 0);
+		return key;
+	}
+
+	//? Sort keys of the processes by position, permuted by proc_sorter()
+	vector<sort_entry> sort_keys;
+
+	//* Fill sort_keys with the key of <field> for every process in <proc_vec>, hidden processes only go last outside of tree mode
+	void fill_sort_keys(const vector<proc_info>& proc_vec, const int field, const bool tree) {
+		sort_keys.resize(proc_vec.size());
+		for (uint32_t i = 0; const auto& p : proc_vec) {
+			auto& key = sort_keys[i];
+			key.pos = i++;
+			key.filtered = (not tree and p.filtered);
+			key.prefix = 0;
+			switch (field) {
+			case 0: key.value = (double)p.pid; 		break;
+			case 1: key.value = 0; key.prefix = p.text->name_key; break;
+			case 2: key.value = 0; key.prefix = p.text->cmd_key; break;
+			case 3: key.value = (double)p.threads;	break;
+			case 4: key.value = 0; key.prefix = p.text->user_key; break;
+			case 5: key.value = (double)p.mem; 		break;
+			case 6: key.value = p.cpu_p;			break;
+			default: key.value = p.cpu_c;			break;
+			}
+		}
+	}
+
+	//? Hidden processes go last, equal keys fall back to the position in <procs>. clear_dead() keeps the relative order of the
+	//? remaining records and new processes are appended, so tied rows keep their order between updates
+	struct sort_compare {
+		const vector<proc_info>& procs;
+		const int field;
+		const bool reverse;
+
+		const string& str_field(const sort_entry& key) const {
+			const auto& p = procs[key.pos];
+			return (field == 1 ? p.name : field == 2 ? p.text->cmd : p.text->user);
+		}
+
+		bool operator()(const sort_entry& a, const sort_entry& b) const {
+			if (a.filtered != b.filtered) return b.filtered;
+			if (a.value != b.value) return (reverse ? a.value < b.value : a.value > b.value);
+			if (a.prefix != b.prefix) return (reverse ? a.prefix < b.prefix : a.prefix > b.prefix);
+			if (field == 1 or field == 2 or field == 4) {
+				if (const int c = str_field(a).compare(str_field(b)); c != 0) return (reverse ? c < 0 : c > 0);
+			}
+			return a.pos < b.pos;
+		}
+	};
+
+	size_t proc_sorter(vector<proc_info>& proc_vec, string sorting, const bool reverse, const bool tree, const bool services, size_t rows) {
+		if (services) {
+			if (sorting == "service") sorting = "program";
+			else if (sorting == "caption") sorting = "command";
+			else if (sorting == "status") sorting = "user";
+		}
+		const int field = v_index(sort_vector, sorting);
+		fill_sort_keys(proc_vec, field, tree);
+		auto& keys = sort_keys;
+		const sort_compare compare{proc_vec, field, reverse};
+
+		if (rows == 0 or rows >= keys.size()) {
+			rows = keys.size();
+			rng::sort(keys, compare);
+		}
+		else {
+			std::nth_element(keys.begin(), keys.begin() + rows, keys.end(), compare);
+			std::sort(keys.begin(), keys.begin() + rows, compare);
+		}
+
+		display_order.resize(keys.size());
+		for (size_t i = 0; i < keys.size(); i++) display_order[i] = keys[i].pos;
+
+		//* When sorting with "cpu lazy" push processes over threshold cpu usage to the front regardless of cumulative usage
+		if (not tree and not reverse and sorting == "cpu lazy") {
+			double max = 10.0, target = 30.0;
+			for (size_t i = 0, x = 0, offset = 0; i < display_order.size(); i++) {
+				const double cpu_p = proc_vec[display_order[i]].cpu_p;
+				if (i <= 5 and cpu_p > max)
+					max = cpu_p;
+				else if (i == 6)
+					target = (max > 30.0) ? max : 10.0;
+				if (i == offset and cpu_p > 30.0)
+					offset++;
+				else if (cpu_p > target) {
+					rotate(display_order.begin() + offset, display_order.begin() + i, display_order.begin() + i + 1);
+					if (++x > 10) break;
+				}
+			}
+		}
+		return rows;
+	}
+
+	//* Append <str> to <out> with ASCII letters folded to lowercase
+	void fold_append(string& out, const string& str) {
+		for (const char c : str) out.push_back((c >= 'A' and c <= 'Z') ? c + ('a' - 'A') : c);
+	}
+
+	void update_search_key(proc_info& p) {
+		auto& text = *p.text;
+		text.name_key = collate_key(p.name);
+		text.cmd_key = collate_key(text.cmd);
+		text.user_key = collate_key(text.user);
+		text.search = to_string(p.pid);
+		text.search.reserve(text.search.size() + p.name.size() + text.cmd.size() + text.user.size() + 3);
+		for (const string* field : {&p.name, &text.cmd, &text.user}) {
+			text.search += '\n';
+			fold_append(text.search, *field);
+		}
+	}
+
+	//* Match a process against an already folded filter, std::string::find skips ahead with memchr so this stays fast on long command lines
+	inline bool filter_match(const proc_info& p, const string& filter_folded) {
+		return p.text->search.find(filter_folded) != string::npos;
+	}
+
+	//* Compare every position with the tree it was built from and rebuild the tree by position if a process appeared, died, changed
+	//* parent or reused a pid, returns true if it did. Children are filed by position until tree_sort_all() orders them
+	bool tree_update(vector<proc_info>& procs) {
+		bool changed = (tree_nodes.size() != procs.size());
+		for (size_t i = 0; i < procs.size() and not changed; i++) {
+			const auto& node = tree_nodes[i];
+			changed = (node.pid != procs[i].pid or node.parent != procs[i].ppid or node.created != procs[i].created);
+		}
+		if (not changed) return false;
+
+		tree_nodes.resize(procs.size());
+		tree_parent_pos.assign(procs.size(), npos);
+		tree_offsets.assign(procs.size() + 1, 0);
+		tree_roots.clear();
+		for (size_t i = 0; auto& p : procs) {
+			if (p.ppid != 0) {
+				const auto parent = proc_index.find(p.ppid);
+				if (p.ppid == p.pid or parent == proc_index.end()) {
+					p.ppid = 0;
+				}
+				else {
+					tree_parent_pos[i] = parent->second;
+					tree_offsets[parent->second + 1]++;
+				}
+			}
+			if (p.ppid == 0) tree_roots.push_back(i);
+			tree_nodes[i] = {p.pid, p.ppid, p.created};
+			i++;
+		}
+		for (size_t i = 1; i < tree_offsets.size(); i++) tree_offsets[i] += tree_offsets[i - 1];
+
+		static vector<size_t> fill;
+		fill.assign(tree_offsets.begin(), tree_offsets.end() - 1);
+		tree_children.resize(procs.size());
+		for (size_t i = 0; i < procs.size(); i++) {
+			if (const size_t parent = tree_parent_pos[i]; parent != npos) tree_children[fill[parent]++] = i;
+		}
+		return true;
+	}
+
+	//* Put the roots and the children of every process in the order proc_sorter() would give them by sorting each group of siblings on
+	//* its own, sort_rank is set to the place of every process among its siblings
+	void tree_sort_all(const vector<proc_info>& procs, const int field, const bool reverse) {
+		fill_sort_keys(procs, field, true);
+		const sort_compare compare{procs, field, reverse};
+		const auto siblings = [&](const vector<size_t>::iterator first, const vector<size_t>::iterator last) {
+			if (last - first > 1) std::sort(first, last, [&](const size_t a, const size_t b) { return compare(sort_keys[a], sort_keys[b]); });
+			for (auto it = first; it != last; ++it) sort_rank[*it] = it - first;
+		};
+		sort_rank.resize(procs.size());
+		siblings(tree_roots.begin(), tree_roots.end());
+		for (size_t parent = 0; parent < procs.size(); parent++) {
+			siblings(tree_children.begin() + tree_offsets[parent], tree_children.begin() + tree_offsets[parent + 1]);
+		}
+	}
+
+	//? Sibling sort key, the field summed for collapsed processes and the place among the siblings from tree_sort_all()
+	struct tree_key {
+		double value;
+		size_t rank, pos;
+	};
+
+	//* Sort sibling positions in [<first>, <last>) by <field> with the summed values of collapsed processes added, ties keep the order
+	//* from tree_sort_all() via sort_rank
+	void tree_sort(const vector<size_t>::iterator first, const vector<size_t>::iterator last, const vector<proc_info>& procs, const int field, const bool reverse) {
+		if (last - first < 2) return;
+		static vector<tree_key> keys;
+		keys.clear();
+		for (auto it = first; it != last; ++it) {
+			const auto& p = procs[*it];
+			double value;
+			switch (field) {
+				case 3: value = (double)p.threads; break;
+				case 5: value = (double)p.mem; break;
+				case 6: value = p.cpu_p; break;
+				default: value = p.cpu_c; break;
+			}
+			keys.push_back({value, sort_rank[*it], *it});
+		}
+		rng::sort(keys, [&](const tree_key& a, const tree_key& b) {
+			if (a.value != b.value) return (reverse ? a.value < b.value : a.value > b.value);
+			return a.rank < b.rank;
+		});
+		for (auto it = first; const auto& key : keys) *it++ = key.pos;
+	}
+
+	//* Sort the roots and the siblings of every shown collapsed process again with the summed values of the collapsed processes, only
+	//* needed when sorting by a field that is summed for them
+	void tree_sort_collapsed(const vector<proc_info>& procs, const int field, const bool reverse) {
+		tree_sort(tree_roots.begin(), tree_roots.end(), procs, field, reverse);
+		for (const auto& sum : collapsed_sums) {
+			if (const size_t parent = tree_parent_pos[sum.pos]; parent != npos) {
+				tree_sort(tree_children.begin() + tree_offsets[parent], tree_children.begin() + tree_offsets[parent + 1], procs, field, reverse);
+			}
+		}
+	}
+
+	//* Take the summed values of hidden children back out of their collapsed parents
+	void tree_remove_totals(vector<proc_info>& procs) {
+		if (not collapsed_added) return;
+		for (const auto& sum : collapsed_sums) {
+			auto& p = procs[sum.pos];
+			p.cpu_p -= sum.cpu_p;
+			p.cpu_c -= sum.cpu_c;
+			p.mem -= sum.mem;
+			p.threads -= sum.threads;
+		}
+		collapsed_added = false;
+	}
+
+	//* Move the sums of every collapsed process by the change in its hidden children since they were last counted and add them to the process
+	void tree_add_totals(vector<proc_info>& procs, const bool count) {
+		if (collapsed_added) return;
+		if (count) {
+			for (auto& counted : collapsed_counted) {
+				const auto& p = procs[counted.pos];
+				auto& sum = collapsed_sums[counted.owner];
+				sum.cpu_p = max(0.0, sum.cpu_p + p.cpu_p - counted.cpu_p);
+				sum.cpu_c = max(0.0, sum.cpu_c + p.cpu_c - counted.cpu_c);
+				sum.mem += p.mem - counted.mem;
+				sum.threads += p.threads - counted.threads;
+				counted.cpu_p = p.cpu_p;
+				counted.cpu_c = p.cpu_c;
+				counted.mem = p.mem;
+				counted.threads = p.threads;
+			}
+		}
+		for (const auto& sum : collapsed_sums) {
+			auto& p = procs[sum.pos];
+			p.cpu_p += sum.cpu_p;
+			p.cpu_c += sum.cpu_c;
+			p.mem += sum.mem;
+			p.threads += sum.threads;
+		}
+		collapsed_added = true;
+	}
+
+	//* First pass over the tree, apply folded <filter>, hide children of collapsed processes and count them in the collapsed_sums entry <owner>
+	void _tree_filter(vector<proc_info>& procs, const size_t pos, size_t depth, const bool hidden, const string& filter, bool found, const size_t owner) {
+		auto& cur_proc = procs[pos];
+		tree_state[pos].visited = 1;
+		bool filtering = false;
+
+		//? If filtering, include children of matching processes
+		if (not found and not filter.empty()) {
+			if (not filter_match(cur_proc, filter)) {
+				filtering = true;
+			}
+			else {
+				found = true;
+				depth = 0;
+			}
+		}
+
+		cur_proc.depth = depth;
+		cur_proc.filtered = (filtering or hidden);
+		tree_state[pos].hidden = cur_proc.filtered;
+		if (cur_proc.filtered) filter_found++;
+
+		if (hidden and owner < collapsed_sums.size()) {
+			auto& sum = collapsed_sums[owner];
+			sum.cpu_p += cur_proc.cpu_p;
+			sum.cpu_c += cur_proc.cpu_c;
+			sum.mem += cur_proc.mem;
+			sum.threads += cur_proc.threads;
+			collapsed_counted.push_back({pos, owner, cur_proc.cpu_p, cur_proc.cpu_c, cur_proc.mem, cur_proc.threads});
+		}
+
+		if (tree_offsets[pos] == tree_offsets[pos + 1]) return;
+
+		//? Children of a shown collapsed process are counted in a new entry, deeper hidden children in the same one
+		const bool collapsed = (hidden or cur_proc.collapsed) and not filtering;
+		size_t child_owner = npos;
+		if (collapsed and hidden) {
+			child_owner = owner;
+		}
+		else if (collapsed) {
+			child_owner = collapsed_sums.size();
+			collapsed_sums.push_back({pos, 0});
+		}
+		for (size_t i = tree_offsets[pos]; i < tree_offsets[pos + 1]; i++) {
+			const size_t child_pos = tree_children[i];
+			if (tree_state[child_pos].visited != 0) continue;
+			_tree_filter(procs, child_pos, depth + 1, hidden or collapsed, filter, found, child_owner);
+		}
+	}
+
+	//* Second pass over the tree (pre-order), put every shown process in <order> and mark the last shown child of every shown process.
+	//* Only reads the tree and the flags by position so the records aren't touched
+	void tree_flatten(vector<size_t>& order) {
+		struct frame {
+			size_t pos, next, last_shown, first;
+		};
+		static vector<frame> stack;
+		const auto visit = [&](const size_t pos) {
+			auto& state = tree_state[pos];
+			state.visited = 2;
+			state.last = false;
+			stack.push_back({pos, tree_offsets[pos], npos, order.size()});
+			if (not state.hidden) order.push_back(pos);
+		};
+
+		for (const auto root : tree_roots) {
+			if (tree_state[root].visited == 2) continue;
+			visit(root);
+			while (not stack.empty()) {
+				auto& top = stack.back();
+				if (top.next < tree_offsets[top.pos + 1]) {
+					if (const size_t child = tree_children[top.next++]; tree_state[child].visited != 2) visit(child);
+					continue;
+				}
+
+				//? Add tree terminator symbol to the last shown child in a sub-tree
+				const size_t pos = top.pos;
+				const bool hidden = tree_state[pos].hidden;
+				if (not hidden and top.last_shown != npos) tree_state[top.last_shown].last = true;
+				tree_rows[pos] = order.size() - top.first;
+				stack.pop_back();
+				if (not stack.empty() and not hidden) stack.back().last_shown = pos;
+			}
+		}
+	}
+
+	//* Put display_order in the new order of the siblings when nothing else changed since tree_flatten(), every shown process still heads
+	//* the same rows so it goes right after the rows of the siblings sorted before it. The last order lists every parent before its
+	//* children, so going through it from the top places every parent before its children are placed after it
+	void tree_reorder(vector<size_t>& order) {
+		static vector<size_t> start;
+		start.resize(tree_rows.size());
+		order.resize(display_order.size());
+		size_t row = 0;
+		for (const auto root : tree_roots) {
+			start[root] = row;
+			order[row] = root;
+			row += tree_rows[root];
+		}
+
+		//? Processes only reachable through a loop are placed as roots, hidden processes keep their place after the shown ones
+		const size_t shown = row;
+		for (size_t i = 0; i < shown; i++) {
+			const size_t pos = display_order[i];
+			size_t last_shown = npos;
+			row = start[pos] + 1;
+			for (size_t c = tree_offsets[pos]; c < tree_offsets[pos + 1]; c++) {
+				const size_t child = tree_children[c];
+				if (tree_state[child].root or tree_state[child].hidden) continue;
+				start[child] = row;
+				order[row] = child;
+				row += tree_rows[child];
+				tree_state[child].last = false;
+				last_shown = child;
+			}
+			if (last_shown != npos) tree_state[last_shown].last = true;
+		}
+		std::copy(display_order.begin() + shown, display_order.end(), order.begin() + shown);
+	}
+
+	//* Set the tree prefix of the shown processes in rows [<start>, <start> + <rows>) of display_order, the only ones drawn
+	void tree_prefixes(vector<proc_info>& procs, const size_t start, const size_t rows) {
+		//? Indentation is copied from one string holding the deepest level seen so far
+		static string indent;
+		static const size_t level = string(" │ ").size();
+		for (size_t i = start; i < min(start + rows, display_order.size()); i++) {
+			const size_t pos = display_order[i];
+			auto& p = procs[pos];
+			if (p.filtered) break;
+			while (indent.size() < p.depth * level) indent += " │ ";
+			auto& prefix = p.text->prefix;
+			prefix.assign(indent, 0, p.depth * level);
+
+			//? Childless roots first and last in the tree get begin/terminator symbols, last shown children get a terminator
+			if (tree_offsets[pos] != tree_offsets[pos + 1]) prefix += (p.collapsed ? "[+]─" : "[-]─");
+			else if (pos == tree_roots.back()) prefix += " └─ ";
+			else if (pos == tree_roots.front()) prefix += " ┌─ ";
+			else prefix += (tree_state[pos].last ? " └─ " : " ├─ ");
+		}
+	}
+
+	void clear_dead(vector<proc_info>& procs, const vector<bool>& alive) {
+		size_t keep = 0;
+		for (size_t i = 0; i < procs.size(); i++) {
+			if (not alive[i]) {
+				proc_index.erase(procs[i].pid);
+				continue;
+			}
+			if (keep != i) {
+				procs[keep] = std::move(procs[i]);
+				proc_index[procs[keep].pid] = keep;
+			}
+			keep++;
+		}
+		procs.erase(procs.begin() + keep, procs.end());
+	}
+
+	void apply_sample(vector<proc_info>& procs, Backend::proc_list& sample, const bool per_core) {
+		const int cmult = (per_core) ? Shared::coreCount : 1;
+		static vector<bool> alive;
+		cputimes = sample.cpu_total;
+
+		tree_remove_totals(procs);
+		alive.assign(procs.size(), false);
+		proc_index.clear();
+		for (size_t i = 0; i < procs.size(); i++) proc_index[procs[i].pid] = i;
+
+		for (auto& s : sample.procs) {
+			size_t index;
+			bool no_cache = false;
+			if (auto find_old = proc_index.find(s.pid); find_old != proc_index.end()) {
+				index = find_old->second;
+				if (auto& old_proc = procs[index]; old_proc.created != s.created) {
+					old_proc = {.pid = s.pid};
+					no_cache = true;
+				}
+			}
+			else {
+				index = procs.size();
+				procs.push_back({.pid = s.pid});
+				proc_index[s.pid] = index;
+				alive.push_back(false);
+				no_cache = true;
+			}
+			alive[index] = true;
+
+			auto& new_proc = procs[index];
+			if (no_cache) {
+				new_proc.created = new_proc.cpu_s = s.created;
+				new_proc.ppid = s.ppid;
+				new_proc.name = std::move(s.name);
+				auto& text = *new_proc.text;
+				text.cmd = std::move(s.cmd);
+				text.user = std::move(s.user);
+				if (text.cmd.empty()) text.cmd = new_proc.name;
+				if (text.user.empty()) text.user = "******";
+				update_search_key(new_proc);
+			}
+			new_proc.threads = s.threads;
+			new_proc.mem = s.mem;
+
+			if (new_proc.cpu_t == 0) new_proc.cpu_t = s.cpu_t;
+			new_proc.cpu_p = clamp(round(cmult * 100 * (s.cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+			new_proc.cpu_c = (double)s.cpu_t / max((uint64_t)1, sample.systime - new_proc.cpu_s);
+			new_proc.cpu_t = s.cpu_t;
+		}
+
+		clear_dead(procs, alive);
+		old_cputimes = cputimes;
+	}
+
+	void arrange(vector<proc_info>& out_vec, const string& sorting, const bool reverse, const string& filter, const bool tree, const bool services,
+				const bool no_update, const bool should_filter, const bool sorted_change) {
+		string filter_folded;
+		fold_append(filter_folded, filter);
+
+		//* Match filter if defined, when only narrowing the last filter there is no need to search processes that didn't match it
+		//* The tree view sets filtered itself and keeps it while the tree, collapsed processes and filter stay the same
+		const bool tree_view = (tree and not services);
+		if (should_filter and not tree_view) {
+			const bool narrow = (no_update and not tree and not narrow_filter.empty() and narrow_services == services
+								and filter_folded.find(narrow_filter) != string::npos);
+			filter_found = 0;
+			for (auto& p : out_vec) {
+				if (not tree and not filter.empty()) {
+					p.filtered = ((narrow and p.filtered) or not filter_match(p, filter_folded));
+					if (p.filtered) filter_found++;
+				}
+				else {
+					p.filtered = false;
+				}
+			}
+			narrow_filter = (tree ? "" : filter_folded);
+			narrow_services = services;
+		}
+
+		//? Sort processes, outside of tree mode only the rows up to one page past the current view are ordered until scrolled to.
+		//? The tree view sorts each group of siblings itself
+		static size_t sorted_rows = 0;
+		const size_t sort_rows = (tree ? 0 : (size_t)max(0, Config::getI("proc_start") + Proc::select_max * 2));
+		if (not tree_view and (sorted_change or not no_update or (not tree and sorted_rows < min(sort_rows, out_vec.size())))) {
+			sorted_rows = proc_sorter(out_vec, sorting, reverse, tree, services, sort_rows);
+		}
+
+		//* Generate tree view if enabled
+		if (tree_view and (not no_update or should_filter or sorted_change)) {
+			static string tree_filter;
+			bool locate_selection = false, toggled = false;
+			if (auto find_pid = (collapse != -1 ? collapse : expand); find_pid != -1) {
+				auto collapser = rng::find(out_vec, find_pid, &proc_info::pid);
+				if (collapser != out_vec.end()) {
+					if (collapse == expand) {
+						collapser->collapsed = not collapser->collapsed;
+					}
+					else if (collapse > -1) {
+						collapser->collapsed = true;
+					}
+					else if (expand > -1) {
+						collapser->collapsed = false;
+					}
+					if (Config::getI("proc_selected") > 0) locate_selection = true;
+					toggled = true;
+				}
+				collapse = expand = -1;
+			}
+			narrow_filter.clear();
+
+			//? Siblings only have to be sorted again when the tree, the collapsed processes, the filter or the sorting changed or the values
+			//? of a field sorted by changed with the update, otherwise the last order, positions and depths still hold
+			const bool changed = tree_update(out_vec);
+			const bool rebuild = (changed or toggled or not tree_built or not filter_folded.empty() or filter_folded != tree_filter);
+			const int field = v_index(sort_vector, sorting);
+			const bool summed = (field == 3 or field >= 5);
+			const bool reorder = (rebuild or sorted_change or (summed and not no_update));
+			if (reorder) tree_remove_totals(out_vec);
+
+			//? Filtering, depth and the hidden children of collapsed processes only change with the tree, otherwise the sums are moved by
+			//? how much the hidden children changed. Search keys can change without changing the tree so a filter is matched every time.
+			//? Processes only reachable through a loop of reused pids are added as roots last
+			if (rebuild) {
+				collapsed_sums.clear();
+				collapsed_counted.clear();
+				filter_found = 0;
+				tree_state.assign(out_vec.size(), {});
+				tree_rows.resize(out_vec.size());
+				tree_roots.resize(rng::partition(tree_roots, [](const size_t pos) { return tree_parent_pos[pos] == npos; }).begin() - tree_roots.begin());
+				for (const auto pos : tree_roots) _tree_filter(out_vec, pos, 0, false, filter_folded, false, npos);
+				for (size_t i = 0; i < out_vec.size(); i++) {
+					if (tree_state[i].visited != 0) continue;
+					tree_roots.push_back(i);
+					_tree_filter(out_vec, i, 0, false, filter_folded, false, npos);
+				}
+				for (const auto pos : tree_roots) tree_state[pos].root = true;
+				tree_filter = filter_folded;
+				tree_built = true;
+			}
+			if (reorder) tree_sort_all(out_vec, field, reverse);
+			tree_add_totals(out_vec, not rebuild);
+			if (summed and reorder and not collapsed_sums.empty()) tree_sort_collapsed(out_vec, field, reverse);
+
+			//? Show in tree order with hidden processes last, only walking the tree again when more than the order of siblings changed
+			if (reorder) {
+				static vector<size_t> order;
+				order.clear();
+				if (rebuild) {
+					tree_flatten(order);
+					for (size_t i = 0; i < out_vec.size(); i++) {
+						if (tree_state[i].hidden) order.push_back(i);
+					}
+				}
+				else {
+					tree_reorder(order);
+				}
+				display_order.swap(order);
+			}
+
+			//? Move current selection/view to the selected process when collapsing/expanding in the tree
+			if (locate_selection and proc_index.contains(Proc::selected_pid)) {
+				const int loc = rng::find(display_order, proc_index.at(Proc::selected_pid)) - display_order.begin();
+				if (Config::getI("proc_start") >= loc or Config::getI("proc_start") <= loc - Proc::select_max)
+					Config::set("proc_start", max(0, loc - 1));
+				Config::set("proc_selected", loc - Config::getI("proc_start") + 1);
+			}
+		}
+		else if (not tree_view) {
+			tree_built = false;
+		}
+
+		numpids = (int)out_vec.size() - filter_found;
+
+		//? Prefixes are only made for the rows that can be drawn, from where the view starts if scrolled to the end with the tallest
+		//? proc box to one row past a full page from the current start
+		if (tree_view and tree_built) {
+			const int start = Config::getI("proc_start");
+			const int first = max(0, min(start, numpids - Proc::select_max));
+			tree_prefixes(out_vec, first, start - first + Proc::select_max + 1);
+		}
+	}
+}
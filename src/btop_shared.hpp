@@ -19,15 +19,60 @@ tab-size = 4
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory>
 #include <filesystem>
 #include <atomic>
-#include <deque>
+#include <span>
+#include <algorithm>
 #include <robin_hood.h>
 #include <array>
 #include <tuple>
 
-using std::string, std::vector, std::deque, robin_hood::unordered_flat_map, std::atomic, std::array, std::tuple;
+using std::string, std::vector, std::span, robin_hood::unordered_flat_map, std::atomic, std::array, std::tuple;
+
+//* History of values for a graph, the values are kept contiguous so they can be handed to Draw::Graph as a span
+//* New values are written behind the newest value, when the end of the storage is reached the values are moved back
+//* to the front, the storage only grows when more than half of it is in use so it settles at about twice the history length
+class history_buffer {
+	vector<long long> values;
+	size_t start = 0, count = 0;
+public:
+	void push_back(const long long value) {
+		if (start + count == values.size()) {
+			if (count * 2 >= values.size()) values.resize(std::max((size_t)32, values.size() * 2));
+			else {
+				std::copy(values.begin() + start, values.begin() + start + count, values.begin());
+				start = 0;
+			}
+		}
+		values[start + count++] = value;
+	}
+
+	void pop_front() {
+		if (count == 0) return;
+		start = (--count == 0 ? 0 : start + 1);
+	}
+
+	//* Drop the oldest values until at most <length> values are left
+	void trim(const size_t length) {
+		if (count <= length) return;
+		start += count - length;
+		count = length;
+	}
+
+	void clear() { start = count = 0; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	long long front() const { return values[start]; }
+	long long back() const { return values[start + count - 1]; }
+	long long operator[](const size_t i) const { return values[start + i]; }
+	const long long* begin() const { return values.data() + start; }
+	const long long* end() const { return values.data() + start + count; }
+	span<const long long> view() const { return { begin(), count }; }
+	operator span<const long long>() const { return view(); }
+};
 
 void term_resize(bool force=false);
 
@@ -43,6 +88,7 @@ namespace Global {
 	extern atomic<bool> resized;
 	extern string overlay;
 	extern string clock;
+	extern bool arg_headless;
 	const string bg_black = "\033[0;40m";
 	const string fg_white = "\033[1;97m";
 	const string fg_green = "\033[1;92m";
@@ -63,6 +109,19 @@ namespace Runner {
 
 }
 
+namespace Backend {
+	struct cpu_sample;
+	struct proc_list;
+}
+
+namespace Draw {
+	//* Output of one box for a cycle, <chrome> holds the parts that only change with size, theme or config and is empty on cycles
+	//* where nothing needs to be written again, <content> holds the values that change every tick and is written after <chrome>
+	struct layers {
+		std::string_view chrome, content;
+	};
+}
+
 namespace Tools {
 	//* Platform specific function for system_uptime (seconds since last restart)
 	double system_uptime();
@@ -77,6 +136,13 @@ namespace Shared {
 
 
 namespace Cpu {
+	//* Fields of cpu_info::cpu_percent, field_names holds the names used in the config and shown in the cpu box
+	enum Fields { CFtotal, CFkernel, CFuser, CFdpc, CFinterrupt, CFidle, CFgpu, CFcount };
+	extern const array<string, CFcount> field_names;
+
+	//* Return field with name <name>, CFtotal if not found
+	Fields field_index(const string& name);
+
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
 	extern bool shown, redraw, got_sensors, cpu_temp_only, has_battery;
@@ -106,18 +172,10 @@ namespace Cpu {
 	};
 
 	struct cpu_info {
-		unordered_flat_map<string, deque<long long>> cpu_percent = {
-			{"total", {}},
-			{"kernel", {}},
-			{"user", {}},
-			{"dpc", {}},
-			{"interrupt", {}},
-			{"idle", {}},
-			{"gpu", {}}
-		};
-		vector<deque<long long>> core_percent;
-		vector<deque<long long>> temp;
-		deque<long long> gpu_temp;
+		array<history_buffer, CFcount> cpu_percent;
+		vector<history_buffer> core_percent;
+		vector<history_buffer> temp;
+		history_buffer gpu_temp;
 		long long temp_max = 100;
 		array<float, 3> load_avg;
 	};
@@ -125,8 +183,11 @@ namespace Cpu {
 	//* Collect cpu stats and temperatures
 	auto collect(const bool no_update=false) -> cpu_info&;
 
+	//* Add usage of every core and field since the last sample to <cpu>, <sample> holds cumulative times for at least Shared::coreCount cores
+	void apply_sample(cpu_info& cpu, const Backend::cpu_sample& sample);
+
 	//* Draw contents of cpu box using <cpu> as source
-	string draw(const cpu_info& cpu, const bool force_redraw=false, const bool data_same=false);
+	Draw::layers draw(const cpu_info& cpu, const bool force_redraw=false, const bool data_same=false);
 
 	extern unordered_flat_map<int, int> core_mapping;
 }
@@ -139,23 +200,23 @@ namespace Mem {
 	extern int64_t totalMem;
 	extern bool cpu_gpu;
 
+	//* Fields of mem_info::stats and mem_info::percent, only used, available, commit, cached, page_used, page_free, gpu_used and gpu_free have percentages
+	enum Stats { MStotal, MSused, MSavailable, MScommit, MScommit_total, MScached, MSpage_total, MSpage_used, MSpage_free, MSgpu_total, MSgpu_used, MSgpu_free, MScount };
+	extern const array<string, MScount> stat_names;
+
 	struct disk_info {
 		string name;
 		int64_t total = 0, used = 0, free = 0;
 		int used_percent = 0, free_percent = 0;
 		array<int64_t, 3> old_io = {0, 0, 0};
-		deque<long long> io_read = {};
-		deque<long long> io_write = {};
-		deque<long long> io_activity = {};
+		history_buffer io_read = {};
+		history_buffer io_write = {};
+		history_buffer io_activity = {};
 	};
 
 	struct mem_info {
-		unordered_flat_map<string, uint64_t> stats =
-		{ {"total", 0}, {"used", 0}, {"available", 0}, {"commit", 0}, {"commit_total", 0}, {"cached", 0},
-			{"page_total", 0}, {"page_used", 0}, {"page_free", 0}, {"gpu_total", 0}, {"gpu_used", 0}, {"gpu_free", 0} };
-		unordered_flat_map<string, deque<long long>> percent =
-		{ {"used", {}}, {"available", {}}, {"commit", {}}, {"cached", {}},
-			{"page_used", {}}, {"page_free", {}}, {"gpu_used", {}}, {"gpu_free", {}} };
+		array<uint64_t, MScount> stats = {};
+		array<history_buffer, MScount> percent;
 		unordered_flat_map<string, disk_info> disks;
 		vector<string> disks_order;
 		bool pagevirt = false;
@@ -165,7 +226,7 @@ namespace Mem {
 	auto collect(const bool no_update=false) -> mem_info&;
 
 	//* Draw contents of mem box using <mem> as source
-	string draw(const mem_info& mem, const bool force_redraw=false, const bool data_same=false);
+	Draw::layers draw(const mem_info& mem, const bool force_redraw=false, const bool data_same=false);
 }
 
 namespace Net {
@@ -175,15 +236,18 @@ namespace Net {
 	extern string selected_iface;
 	extern vector<string> interfaces;
 	extern bool rescale;
-	extern unordered_flat_map<string, uint64_t> graph_max;
+	//* Directions of net_info::bandwidth and net_info::stat, dir_names holds the names used for themes and display
+	enum Directions { NDdownload, NDupload, NDcount };
+	extern const array<string, NDcount> dir_names;
+	extern array<uint64_t, NDcount> graph_max;
 
 	struct net_stat {
 		uint64_t speed = 0, top = 0, total = 0, last = 0, offset = 0, rollover = 0;
 	};
 
 	struct net_info {
-		unordered_flat_map<string, deque<long long>> bandwidth = { {"download", {}}, {"upload", {}} };
-		unordered_flat_map<string, net_stat> stat = { {"download", {}}, {"upload", {}} };
+		array<history_buffer, NDcount> bandwidth;
+		array<net_stat, NDcount> stat = {};
 		string ipv4 = "", ipv6 = "";
 		bool connected = false;
 	};
@@ -194,7 +258,7 @@ namespace Net {
 	auto collect(const bool no_update=false) -> net_info&;
 
 	//* Draw contents of net box using <net> as source
-	string draw(const net_info& net, const bool force_redraw=false, const bool data_same=false);
+	Draw::layers draw(const net_info& net, const bool force_redraw=false, const bool data_same=false);
 }
 
 namespace Proc {
@@ -248,20 +312,32 @@ namespace Proc {
 		{'P', "Parked"}
 	};
 
-	//* Container for process information
+	//* Strings of a process only read when its line is drawn, when filtering or when sorting by a string field, kept out of proc_info
+	//* so updating and sorting walks the small records only. search holds "pid\nname\ncmd\nuser" folded for the filter and the keys
+	//* are the collation prefixes of name, cmd and user, both rebuilt by update_search_key()
+	struct proc_text {
+		string cmd = "";
+		string short_cmd = "";
+		string user = "";
+		string prefix = "";
+		string search = "";
+		uint64_t name_key = 0, cmd_key = 0, user_key = 0;
+	};
+
+	//* Container for process information, fields read every update and by sorting, name is kept since most views show and sort by it.
+	//* Copies share the proc_text of the process
 	struct proc_info {
 		size_t pid = 0;
-		string name = "", cmd = "";
-		string short_cmd = "";
 		size_t threads = 0;
-		string user = "";
 		uint64_t mem = 0;
 		double cpu_p = 0.0, cpu_c = 0.0;
+		uint64_t ppid = 0, cpu_s = 0, cpu_t = 0;
+		uint64_t created = 0;
+		size_t depth = 0;
 		char state = '0';
-		uint64_t ppid = 0, cpu_s = 0, cpu_t = 0, p_nice = 0;
-		string prefix = "";
-		size_t depth = 0, tree_index = 0;
 		bool collapsed = false, filtered = false, WMI = false;
+		string name = "";
+		std::shared_ptr<proc_text> text = std::make_shared<proc_text>();
 	};
 
 	//* Container for process info box
@@ -270,8 +346,8 @@ namespace Proc {
 		proc_info entry;
 		string elapsed, parent, status, io_read, io_write, memory, owner, start, description, last_name, service_type;
 		long long first_mem = -1;
-		deque<long long> cpu_percent;
-		deque<long long> mem_bytes;
+		history_buffer cpu_percent;
+		history_buffer mem_bytes;
 		double mem_percent = 0.0;
 		bool can_pause = false;
 		bool can_stop = false;
@@ -280,12 +356,40 @@ namespace Proc {
 	//? Contains all info for proc detailed box
 	extern detail_container detailed;
 
+	//? Positions in the vector returned by collect() in the order they are shown
+	extern vector<size_t> display_order;
+
+	//? Positions in the vector returned by collect() by pid, records only move when dead entries are cleared
+	extern unordered_flat_map<size_t, size_t> proc_index;
+
+	//? Summed cpu time of all processes at the current and the previous update
+	extern uint64_t cputimes, old_cputimes;
+
 	//* Collect and sort process information from /proc
 	auto collect(const bool no_update=false) -> vector<proc_info>&;
 
+	//* Rebuild the search text and collation keys of <p>, only needed when its name, cmd or user changes
+	void update_search_key(proc_info& p);
+
+	//* Sort <proc_vec> into display_order, when <rows> is set outside of tree mode only the first <rows> shown processes are put in order, returns the number of ordered rows
+	size_t proc_sorter(vector<proc_info>& proc_vec, string sorting, const bool reverse, const bool tree = false, const bool services = false, size_t rows = 0);
+
+	//* Take the summed values of hidden children back out of collapsed processes in the tree view, called before new values are collected
+	void tree_remove_totals(vector<proc_info>& procs);
+
+	//* Remove processes not marked in <alive> from <procs> and move the index of any shifted entries
+	void clear_dead(vector<proc_info>& procs, const vector<bool>& alive);
+
+	//* Update <procs> from a collector backend sample, new processes take name, cmd and user from the sample
+	void apply_sample(vector<proc_info>& procs, Backend::proc_list& sample, const bool per_core);
+
+	//* Filter and sort <out_vec> into display_order and generate the tree view if <tree> is set, the steps of collect() that don't depend on where the processes came from
+	void arrange(vector<proc_info>& out_vec, const string& sorting, const bool reverse, const string& filter, const bool tree, const bool services,
+				const bool no_update, const bool should_filter, const bool sorted_change);
+
 	//* Update current selection and view, returns -1 if no change otherwise the current selection
 	int selection(const string& cmd_key);
 
 	//* Draw contents of proc box using <plist> as data source
-	string draw(const vector<proc_info>& plist, const bool force_redraw=false, const bool data_same=false);
+	Draw::layers draw(const vector<proc_info>& plist, const bool force_redraw=false, const bool data_same=false);
 }
@@ -43,6 +43,26 @@ namespace Theme {
 	unordered_flat_map<string, string> colors;
 	unordered_flat_map<string, array<int, 3>> rgbs;
 	unordered_flat_map<string, array<string, 101>> gradients;
+	array<string, color_names.size()> color_table;
+	array<array<string, 101>, gradient_names.size()> gradient_table;
+	array<bool, color_names.size()> color_defined = {};
+	array<bool, gradient_names.size()> gradient_defined = {};
+
+	void undefined(const char* func, std::string_view name) {
+		throw std::out_of_range("Theme::" + string(func) + "() -> Not defined by the current theme: " + string(name));
+	}
+
+	color_id::color_id(const string& name) {
+		const auto it = rng::find(color_names, name);
+		if (it == color_names.end()) throw std::out_of_range("Theme::color_id() -> Unknown color: " + name);
+		index = (uint16_t)(it - color_names.begin());
+	}
+
+	gradient_id::gradient_id(const string& name) {
+		const auto it = rng::find(gradient_names, name);
+		if (it == gradient_names.end()) throw std::out_of_range("Theme::gradient_id() -> Unknown gradient: " + name);
+		index = (uint16_t)(it - gradient_names.begin());
+	}
 
 	const unordered_flat_map<string, string> Default_theme = {
 		{ "main_bg", "#00" },
@@ -442,6 +462,19 @@ namespace Theme {
 		Term::fg = colors.at("main_fg");
 		Term::bg = colors.at("main_bg");
 		Fx::reset = Fx::reset_base + Term::fg + Term::bg;
+
+		//? Copy to the tables used by c() and g() so draw code never looks up colors by name
+		for (size_t i = 0; i < color_names.size(); i++) {
+			const auto it = colors.find(string(color_names[i]));
+			color_defined[i] = (it != colors.end());
+			color_table[i] = (color_defined[i] ? it->second : "");
+		}
+		for (size_t i = 0; i < gradient_names.size(); i++) {
+			const auto it = gradients.find(string(gradient_names[i]));
+			gradient_defined[i] = (it != gradients.end());
+			if (gradient_defined[i]) gradient_table[i] = it->second;
+			else gradient_table[i].fill("");
+		}
 	}
 
 }
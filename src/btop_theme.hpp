@@ -19,6 +19,8 @@ tab-size = 4
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <robin_hood.h>
 #include <array>
 #include <filesystem>
@@ -54,13 +56,61 @@ namespace Theme {
 	extern unordered_flat_map<string, array<int, 3>> rgbs;
 	extern unordered_flat_map<string, array<string, 101>> gradients;
 
-	//* Return escape code for color <name>
-	inline const string& c(const string& name) { return colors.at(name); }
-
-	//* Return array of escape codes for color gradient <name>
-	inline const array<string, 101>& g(string name) { return gradients.at(name); }
+	//? Names of all theme colors and gradients, the position of a name is the index used by color_id and gradient_id
+	constexpr array<std::string_view, 45> color_names = {
+		"main_bg", "main_fg", "title", "hi_fg", "selected_bg", "selected_fg", "inactive_fg", "graph_text", "meter_bg", "proc_misc",
+		"cpu_box", "mem_box", "net_box", "proc_box", "div_line",
+		"temp_start", "temp_mid", "temp_end", "cpu_start", "cpu_mid", "cpu_end", "free_start", "free_mid", "free_end",
+		"cached_start", "cached_mid", "cached_end", "available_start", "available_mid", "available_end", "used_start", "used_mid", "used_end",
+		"download_start", "download_mid", "download_end", "upload_start", "upload_mid", "upload_end",
+		"process_start", "process_mid", "process_end", "virtual_start", "virtual_mid", "virtual_end"
+	};
+	constexpr array<std::string_view, 12> gradient_names = {
+		"temp", "cpu", "free", "cached", "available", "used", "download", "upload", "process", "virtual", "proc", "proc_color"
+	};
+
+	//? Colors and gradients of the current theme indexed by color_id and gradient_id, and which of them the theme defines
+	extern array<string, color_names.size()> color_table;
+	extern array<array<string, 101>, gradient_names.size()> gradient_table;
+	extern array<bool, color_names.size()> color_defined;
+	extern array<bool, gradient_names.size()> gradient_defined;
+
+	//* Throw std::out_of_range for color or gradient <name> not defined by the current theme
+	[[noreturn]] void undefined(const char* func, std::string_view name);
+
+	template<size_t N>
+	consteval uint16_t name_index(const array<std::string_view, N>& names, std::string_view name) {
+		for (size_t i = 0; i < N; i++) if (names[i] == name) return (uint16_t)i;
+		throw "Unknown theme color or gradient name";
+	}
+
+	//* Index of a color, string literals are resolved at compile time, other strings with a lookup that throws std::out_of_range for unknown names
+	struct color_id {
+		uint16_t index;
+		consteval color_id(const char* name) : index(name_index(color_names, name)) {}
+		color_id(const string& name);
+	};
+
+	//* Index of a gradient, resolved the same way as color_id
+	struct gradient_id {
+		uint16_t index;
+		consteval gradient_id(const char* name) : index(name_index(gradient_names, name)) {}
+		gradient_id(const string& name);
+	};
+
+	//* Return escape code for color <id>, throws std::out_of_range if the theme doesn't define it
+	inline const string& c(const color_id id) {
+		if (not color_defined[id.index]) undefined("c", color_names[id.index]);
+		return color_table[id.index];
+	}
+
+	//* Return array of escape codes for color gradient <id>, throws std::out_of_range if the theme doesn't define it
+	inline const array<string, 101>& g(const gradient_id id) {
+		if (not gradient_defined[id.index]) undefined("g", gradient_names[id.index]);
+		return gradient_table[id.index];
+	}
 
 	//* Return array of red, green and blue in decimal for color <name>
-	inline const std::array<int, 3>& dec(string name) { return rgbs.at(name); }
+	inline const std::array<int, 3>& dec(const string& name) { return rgbs.at(name); }
 
 }
\ No newline at end of file
@@ -28,14 +28,16 @@ tab-size = 4
 #include <widechar_width.hpp>
 #include <codecvt>
 
-#define _WIN32_DCOM
-#define _WIN32_WINNT 0x0600
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
-#define VC_EXTRALEAN
-#include <comutil.h>
-#include <winsock.h>
-#include <comdef.h>
+#ifdef _WIN32
+	#define _WIN32_DCOM
+	#define _WIN32_WINNT 0x0600
+	#define NOMINMAX
+	#define WIN32_LEAN_AND_MEAN
+	#define VC_EXTRALEAN
+	#include <comutil.h>
+	#include <winsock.h>
+	#include <comdef.h>
+#endif
 
 #include <btop_shared.hpp>
 #include <btop_tools.hpp>
@@ -47,6 +49,30 @@ namespace rng = std::ranges;
 
 //? ------------------------------------------------- NAMESPACES ------------------------------------------------------
 
+//* Escape sequence helpers that need a translation unit
+namespace Fx {
+
+	string uncolor(string s) {
+		size_t out = 0;
+		const size_t len = s.size();
+		for (size_t i = 0; i < len;) {
+			//? Look for "ESC[" followed by at least one digit and any mix of digits and ';' terminated by 'm'
+			if (s[i] == '\x1b' and i + 2 < len and s[i + 1] == '[' and isdigit(static_cast<unsigned char>(s[i + 2]))) {
+				size_t end = i + 3;
+				while (end < len and (isdigit(static_cast<unsigned char>(s[end])) or s[end] == ';')) ++end;
+				if (end < len and s[end] == 'm') {
+					i = end + 1;
+					continue;
+				}
+			}
+			s[out++] = s[i++];
+		}
+		s.resize(out);
+		return s;
+	}
+
+}
+
 //* Collection of escape codes and functions for terminal manipulation
 namespace Term {
 
@@ -54,22 +80,6 @@ namespace Term {
 	atomic<int> width = 0;
 	atomic<int> height = 0;
 	string current_tty;
-	DWORD out_saved_mode;
-	DWORD in_saved_mode;
-
-	bool refresh(bool only_check) {
-		CONSOLE_SCREEN_BUFFER_INFO csbi;
-		
-		if (not GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) return false;
-		if (width != csbi.srWindow.Right - csbi.srWindow.Left + 1 or height != csbi.srWindow.Bottom - csbi.srWindow.Top + 1) {
-			if (not only_check) {
-				width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
-				height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
-			}
-			return true;
-		}
-		return false;
-	}
 
 	auto get_min_size(const string& boxes) -> array<int, 2> {
 		const bool cpu = boxes.find("cpu") != string::npos;
@@ -89,6 +99,24 @@ namespace Term {
 		return { width, height };
 	}
 
+#ifdef _WIN32
+	DWORD out_saved_mode;
+	DWORD in_saved_mode;
+
+	bool refresh(bool only_check) {
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		
+		if (not GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) return false;
+		if (width != csbi.srWindow.Right - csbi.srWindow.Left + 1 or height != csbi.srWindow.Bottom - csbi.srWindow.Top + 1) {
+			if (not only_check) {
+				width = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+				height = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+			}
+			return true;
+		}
+		return false;
+	}
+
 	void set_modes() {
 		static HANDLE handleOut = GetStdHandle(STD_OUTPUT_HANDLE);
 		static HANDLE handleIn = GetStdHandle(STD_INPUT_HANDLE);
@@ -145,12 +173,14 @@ namespace Term {
 			initialized = false;
 		}
 	}
+#endif
 }
 
 //? --------------------------------------------------- FUNCTIONS -----------------------------------------------------
 
 namespace Tools {
 
+#ifdef _WIN32
 	HandleWrapper::HandleWrapper() : wHandle(nullptr) { ; }
 	HandleWrapper::HandleWrapper(HANDLE nHandle) : wHandle(nHandle) { valid = (wHandle != INVALID_HANDLE_VALUE); }
 	HANDLE HandleWrapper::operator()() { return wHandle; }
@@ -261,8 +291,11 @@ namespace Tools {
 
 		return ERROR_SUCCESS;
 	}
+#endif
 
 	size_t wide_ulen(const string& str) {
+		//? Printable ASCII is one column per byte, no need to convert
+		if (std::ranges::all_of(str, [](const char c) { return c >= ' ' and c <= '~'; })) return str.size();
 		unsigned int chars = 0;
 		try {
 			std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
@@ -427,34 +460,45 @@ namespace Tools {
 		return (newstr.empty()) ? str : newstr + (string)oldstr;
 	}
 
-	string sec_to_dhms(size_t seconds, bool no_days, bool no_seconds) {
+	short_string dhms(size_t seconds, bool no_days, bool no_seconds) {
 		size_t days = seconds / 86400; seconds %= 86400;
 		size_t hours = seconds / 3600; seconds %= 3600;
 		size_t minutes = seconds / 60; seconds %= 60;
-		string out 	= (not no_days and days > 0 ? to_string(days) + "d " : "")
-					+ (hours < 10 ? "0" : "") + to_string(hours) + ':'
-					+ (minutes < 10 ? "0" : "") + to_string(minutes)
-					+ (not no_seconds ? ":" + string(std::cmp_less(seconds, 10) ? "0" : "") + to_string(seconds) : "");
+		short_string out;
+		if (not no_days and days > 0) {
+			out.number(days);
+			out.append("d ");
+		}
+		if (hours < 10) out.push_back('0');
+		out.number(hours);
+		out.push_back(':');
+		if (minutes < 10) out.push_back('0');
+		out.number(minutes);
+		if (not no_seconds) {
+			out.push_back(':');
+			if (seconds < 10) out.push_back('0');
+			out.number(seconds);
+		}
 		return out;
 	}
 
-	string floating_humanizer(uint64_t value, const bool shorten, size_t start, const bool bit, const bool per_second) {
-		string out;
+	short_string humanized(uint64_t value, const bool shorten, size_t start, const bool bit, const bool per_second) {
 		const size_t mult = (bit) ? 8 : 1;
 		const bool mega = Config::getB("base_10_sizes");
-		static const array<string, 11> mebiUnits_bit = {"bit", "Kib", "Mib", "Gib", "Tib", "Pib", "Eib", "Zib", "Yib", "Bib", "GEb"};
-		static const array<string, 11> mebiUnits_byte = {"Byte", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", "BiB", "GEB"};
-		static const array<string, 11> megaUnits_bit = {"bit", "Kb", "Mb", "Gb", "Tb", "Pb", "Eb", "Zb", "Yb", "Bb", "Gb"};
-		static const array<string, 11> megaUnits_byte = {"Byte", "KB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", "BB", "GB"};
+		static constexpr array<string_view, 11> mebiUnits_bit = {"bit", "Kib", "Mib", "Gib", "Tib", "Pib", "Eib", "Zib", "Yib", "Bib", "GEb"};
+		static constexpr array<string_view, 11> mebiUnits_byte = {"Byte", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", "BiB", "GEB"};
+		static constexpr array<string_view, 11> megaUnits_bit = {"bit", "Kb", "Mb", "Gb", "Tb", "Pb", "Eb", "Zb", "Yb", "Bb", "Gb"};
+		static constexpr array<string_view, 11> megaUnits_byte = {"Byte", "KB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", "BB", "GB"};
 		const auto& units = (bit) ? ( mega ? megaUnits_bit : mebiUnits_bit) : ( mega ? megaUnits_byte : mebiUnits_byte);
 
 		value *= 100 * mult;
 
+		bool below_100 = false;
 		if (mega) {
 			while (value >= 100000) {
 				value /= 1000;
 				if (value < 100) {
-					out = to_string(value);
+					below_100 = true;
 					break;
 				}
 				start++;
@@ -464,28 +508,55 @@ namespace Tools {
 			while (value >= 102400) {
 				value >>= 10;
 				if (value < 100) {
-					out = to_string(value);
+					below_100 = true;
 					break;
 				}
 				start++;
 			}
 		}
-		if (out.empty()) {
-			out = to_string(value);
-			if (not mega and out.size() == 4 and start > 0) { out.pop_back(); out.insert(2, ".");}
-			else if (out.size() == 3 and start > 0) out.insert(1, ".");
-			else if (out.size() >= 2) out.resize(out.size() - 2);
-		}
+
+		//? Digits of <value> with two decimals, shown with one or two decimals when scaled or with the decimals dropped
+		char digits[24];
+		size_t len = std::to_chars(digits, digits + sizeof(digits), value).ptr - digits;
+		char num[24];
+		size_t num_len = 0, dot = string::npos;
+		auto add = [&](const char* from, const size_t count) { std::copy_n(from, count, num + num_len); num_len += count; };
+		if (below_100) add(digits, len);
+		else if (not mega and len == 4 and start > 0) { add(digits, 2); dot = num_len; add(".", 1); add(digits + 2, 1); }
+		else if (len == 3 and start > 0) { add(digits, 1); dot = num_len; add(".", 1); add(digits + 1, 2); }
+		else add(digits, (len >= 2 ? len - 2 : len));
+
+		short_string out;
 		if (shorten) {
-			auto f_pos = out.find('.');
-			if (f_pos == 1 and out.size() > 3) out = to_string(round(stof(out) * 10) / 10).substr(0,3);
-			else if (f_pos != string::npos) out = to_string((int)round(stof(out)));
-			if (out.size() > 3) { out = to_string((int)(out[0] - '0') + 1); start++;}
+			//? Rounded with the same float math as the string based version for identical results
+			float parsed = 0;
+			std::from_chars(num, num + num_len, parsed);
+			if (dot == 1 and num_len > 3) {
+				const int tenths = (int)std::round(parsed * 10);
+				if (tenths < 100) {
+					out.push_back('0' + tenths / 10);
+					out.push_back('.');
+					out.push_back('0' + tenths % 10);
+				}
+				else out.append("10.");
+			}
+			else if (dot != string::npos) out.number((uint64_t)std::round(parsed));
+			else out.append({num, num_len});
+			if (out.size() > 3) {
+				const int first = out.data()[0] - '0';
+				out = {};
+				out.number(first + 1);
+				start++;
+			}
 			out.push_back(units[start][0]);
 		}
-		else out += " " + units[start];
+		else {
+			out.append({num, num_len});
+			out.push_back(' ');
+			out.append(units[start]);
+		}
 
-		if (per_second) out += (bit) ? "ps" : "/s";
+		if (per_second) out.append((bit) ? "ps" : "/s");
 		return out;
 	}
 
@@ -500,8 +571,12 @@ namespace Tools {
 
 	string strf_time(const string& strf) {
 		const time_t in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-		std::stringstream ss;
 		struct tm* bt = localtime(&in_time_t);
+
+		//? strftime() returns 0 if the result didn't fit, put_time() is only used for those and for formats that give an empty string
+		char buf[256];
+		if (const size_t len = std::strftime(buf, sizeof(buf), strf.c_str(), bt); len > 0) return string(buf, len);
+		std::stringstream ss;
 		ss << std::put_time(bt, strf.c_str());
 		return ss.str();
 	}
@@ -574,6 +649,7 @@ namespace Tools {
 		return (user != NULL ? user : "unknown");
 	}
 
+#ifdef _WIN32
 	bool ExecCMD(const string& cmd, string& ret) {
 		static const size_t OUTPUTBUFSIZE = 4096 * 10;
 		
@@ -683,6 +759,7 @@ namespace Tools {
 		GlobalFree(cbuff);
 		return true;
 	}
+#endif
 
 }
 
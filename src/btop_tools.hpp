@@ -22,17 +22,23 @@ tab-size = 4
 #include <vector>
 #include <array>
 #include <atomic>
-#include <regex>
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <ranges>
 #include <chrono>
 #include <thread>
 #include <tuple>
+#include <charconv>
+#include <concepts>
+#include <string_view>
 #include <robin_hood.h>
 #include <limits.h>
-#define WIN32_LEAN_AND_MEAN
-#define VC_EXTRALEAN
-#include <windows.h>
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define VC_EXTRALEAN
+	#include <windows.h>
+#endif
 
 using std::string, std::vector, std::atomic, std::to_string, std::tuple, std::array, robin_hood::unordered_flat_map;
 
@@ -63,14 +69,8 @@ namespace Fx {
 	//* Reset text effects and restore theme foregrund and background color
 	extern string reset;
 
-	//* Regex for matching color, style and cursor move escape sequences
-	const std::regex escape_regex("\033\\[\\d+;?\\d?;?\\d*;?\\d*;?\\d*(m|f|s|u|C|D|A|B){1}");
-
-	//* Regex for matching only color and style escape sequences
-	const std::regex color_regex("\033\\[\\d+;?\\d?;?\\d*;?\\d*;?\\d*(m){1}");
-
-	//* Return a string with all colors and text styling removed
-	inline string uncolor(const string& s) { return std::regex_replace(s, color_regex, ""); }
+	//* Return a string with all colors and text styling removed, strips SGR sequences in a single pass
+	string uncolor(string s);
 	
 	const string bg_black = e + "40m";
 	const string fg_white = e + "97m";
@@ -104,6 +104,137 @@ namespace Mv {
 	const string restore = Fx::e + "u";
 }
 
+//* Escape sequences and text written straight into a caller owned string, for building output without temporary strings
+namespace Esc {
+
+	//? Cursor move, <code> is the final character of the sequence, <col> is only used for absolute moves
+	struct move { char code; int line, col; };
+
+	//* Move cursor to <line>, <column>
+	constexpr move to(const int line, const int col) { return {'f', line, col}; }
+
+	//* Move cursor right <x> columns
+	constexpr move r(const int x) { return {'C', x, 0}; }
+
+	//* Move cursor left <x> columns
+	constexpr move l(const int x) { return {'D', x, 0}; }
+
+	//* Move cursor up <x> lines
+	constexpr move u(const int x) { return {'A', x, 0}; }
+
+	//* Move cursor down <x> lines
+	constexpr move d(const int x) { return {'B', x, 0}; }
+
+	//? <str> written <count> times
+	struct repeated { std::string_view str; int count; };
+
+	//* Write <str> <count> times, same as Tools::operator*
+	constexpr repeated repeat(std::string_view str, const int count) { return {str, count}; }
+
+	//? Number padded with spaces to <width> characters and cut to <width> if longer, same as Tools::rjust/ljust of to_string()
+	struct justified { long long value; int width; bool right; };
+
+	constexpr justified rjust(const long long value, const int width) { return {value, width, true}; }
+	constexpr justified ljust(const long long value, const int width) { return {value, width, false}; }
+
+	//? Text padded with spaces to <width> and cut to <width> if longer, <align> is 'l', 'r', 'c' or 0 to only cut, <utf> counts UTF-8 characters instead of bytes
+	struct justified_text { std::string_view text; int width; char align; bool utf; };
+
+	//* Same as Tools::ljust/rjust/cjust/uresize without wide character support
+	constexpr justified_text ljust(const std::string_view text, const int width, const bool utf=false) { return {text, width, 'l', utf}; }
+	constexpr justified_text rjust(const std::string_view text, const int width, const bool utf=false) { return {text, width, 'r', utf}; }
+	constexpr justified_text cjust(const std::string_view text, const int width, const bool utf=false) { return {text, width, 'c', utf}; }
+	constexpr justified_text uresize(const std::string_view text, const int width) { return {text, width, 0, true}; }
+
+	//? 24-bit foreground or background color
+	struct rgb { int r, g, b; bool bg; };
+
+	constexpr rgb fg(const int r, const int g, const int b) { return {r, g, b, false}; }
+	constexpr rgb bg(const int r, const int g, const int b) { return {r, g, b, true}; }
+
+	//* Appends to <out> with operator<<, numbers are formatted with std::to_chars so nothing is allocated unless <out> has to grow
+	class writer {
+		string& out;
+
+		template<std::integral T>
+		void number(const T value) {
+			char buf[24];
+			out.append(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr);
+		}
+
+	public:
+		explicit writer(string& out) : out(out) {}
+
+		writer& operator<<(const std::string_view str) { out.append(str); return *this; }
+		writer& operator<<(const char c) { out.push_back(c); return *this; }
+
+		template<std::integral T>
+		writer& operator<<(const T value) { number(value); return *this; }
+
+		writer& operator<<(const move& m) {
+			out.append("\033[");
+			number(m.line);
+			if (m.code == 'f') {
+				out.push_back(';');
+				number(m.col);
+			}
+			out.push_back(m.code);
+			return *this;
+		}
+
+		writer& operator<<(const repeated& rep) {
+			for (int i = 0; i < rep.count; i++) out.append(rep.str);
+			return *this;
+		}
+
+		writer& operator<<(const justified& num) {
+			char buf[24];
+			const int len = std::to_chars(buf, buf + sizeof(buf), num.value).ptr - buf;
+			if (len >= num.width) out.append(buf, std::max(num.width, 0));
+			else if (num.right) out.append(num.width - len, ' ').append(buf, len);
+			else out.append(buf, len).append(num.width - len, ' ');
+			return *this;
+		}
+
+		writer& operator<<(const justified_text& txt) {
+			//? Negative widths wrap around in the size_t parameters of the Tools versions, the text is kept as is except by uresize with -1
+			if (txt.width < 0) {
+				if (txt.align != 0 or txt.width < -1) out.append(txt.text);
+				return *this;
+			}
+			const size_t width = txt.width;
+			size_t len = txt.text.size(), cut = std::min(len, width);
+			if (txt.utf) {
+				len = 0;
+				for (size_t i = 0; i < txt.text.size(); i++) {
+					if ((static_cast<unsigned char>(txt.text[i]) & 0xC0) == 0x80) continue;
+					if (len++ == width) cut = i;
+				}
+				if (len <= width) cut = txt.text.size();
+			}
+			if (len >= width or txt.align == 0) {
+				out.append(txt.text.substr(0, cut));
+				return *this;
+			}
+			const size_t pad = width - len;
+			const size_t left = (txt.align == 'r' ? pad : (txt.align == 'c' ? (pad + 1) / 2 : 0));
+			out.append(left, ' ').append(txt.text).append(pad - left, ' ');
+			return *this;
+		}
+
+		writer& operator<<(const rgb& color) {
+			out.append(color.bg ? "\033[48;2;" : "\033[38;2;");
+			number(color.r);
+			out.push_back(';');
+			number(color.g);
+			out.push_back(';');
+			number(color.b);
+			out.push_back('m');
+			return *this;
+		}
+	};
+}
+
 //* Collection of escape codes and functions for terminal manipulation
 namespace Term {
 	extern atomic<bool> initialized;
@@ -134,6 +265,7 @@ namespace Term {
 	void restore();
 }
 
+#ifdef _WIN32
 namespace Tools {
 	class HandleWrapper {
 	public:
@@ -180,6 +312,7 @@ namespace Tools {
 	//? Set start type for service
 	DWORD ServiceSetStart(string name, DWORD start_type);
 }
+#endif
 
 //? --------------------------------------------------- FUNCTIONS -----------------------------------------------------
 
@@ -328,14 +461,44 @@ namespace Tools {
 	//* Replace whitespaces " " with escape code for move right
 	string trans(const string& str);
 
+	//* Up to 31 characters kept in a fixed buffer, returned by the formatting functions below so formatting doesn't allocate
+	//* Converts to string_view so it can be written straight into an Esc::writer
+	class short_string {
+		array<char, 31> buf;
+		uint8_t len = 0;
+	public:
+		void append(const std::string_view str) {
+			const size_t count = std::min(str.size(), buf.size() - len);
+			std::copy_n(str.data(), count, buf.data() + len);
+			len += count;
+		}
+		void push_back(const char c) { if (len < buf.size()) buf[len++] = c; }
+		void number(const uint64_t value) {
+			const auto [end, error] = std::to_chars(buf.data() + len, buf.data() + buf.size(), value);
+			if (error == std::errc()) len = end - buf.data();
+		}
+		const char* data() const { return buf.data(); }
+		size_t size() const { return len; }
+		operator std::string_view() const { return {buf.data(), len}; }
+		string str() const { return {buf.data(), len}; }
+	};
+
+	//* Convert seconds to format "<days>d <hours>:<minutes>:<seconds>"
+	short_string dhms(size_t seconds, bool no_days=false, bool no_seconds=false);
+
 	//* Convert seconds to format "<days>d <hours>:<minutes>:<seconds>" and return string
-	string sec_to_dhms(size_t seconds, bool no_days=false, bool no_seconds=false);
+	inline string sec_to_dhms(size_t seconds, bool no_days=false, bool no_seconds=false) { return dhms(seconds, no_days, no_seconds).str(); }
 
-	//* Scales up in steps of 1024 to highest positive value unit and returns string with unit suffixed
+	//* Scales up in steps of 1024 to highest positive value unit and returns the value with unit suffixed
 	//* bit=True or defaults to bytes
 	//* start=int to set 1024 multiplier starting unit
 	//* short=True always returns 0 decimals and shortens unit to 1 character
-	string floating_humanizer(uint64_t value, const bool shorten=false, size_t start=0, const bool bit=false, const bool per_second=false);
+	short_string humanized(uint64_t value, const bool shorten=false, size_t start=0, const bool bit=false, const bool per_second=false);
+
+	//* Same as humanized() returned as a string
+	inline string floating_humanizer(uint64_t value, const bool shorten=false, size_t start=0, const bool bit=false, const bool per_second=false) {
+		return humanized(value, shorten, start, bit, per_second).str();
+	}
 
 	//* Add std::string operator * : Repeat string <str> <n> number of times
 	std::string operator*(const string& str, int64_t n);
@@ -25,7 +25,6 @@ tab-size = 4
 
 #include <iostream>
 #include <algorithm>
-#include <regex>
 #include <sstream>
 #include <iomanip>
 #include <wincrypt.h>
@@ -44,6 +43,8 @@ namespace WebSocket {
 	atomic<bool> should_stop{false};
 	int port = 8080;
 	thread server_thread;
+	atomic<int> active_clients{0};
+	atomic<bool> client_joined{false};
 	vector<Client> clients;
 	VT::Renderer vt_renderer(120, 30); // Default terminal size
 	SOCKET server_socket = INVALID_SOCKET;
@@ -217,6 +218,8 @@ namespace WebSocket {
 		
 		// Add client to the list
 		clients.emplace_back(client_socket);
+		active_clients++;
+		client_joined = true;
 		
 		// Keep connection alive and handle incoming messages
 		while (!should_stop) {
@@ -258,6 +261,7 @@ namespace WebSocket {
 		}
 		
 		closesocket(client_socket);
+		active_clients--;
 		Logger::info("WebSocket client disconnected");
 	}
 	
@@ -416,29 +420,33 @@ namespace WebSocket {
 
 
 
-	string processToResoniteHTML(const string& ansi_output) {
+	string processToResoniteHTML(const vector<string_view>& frame) {
 		// Update VT renderer size to match current terminal size
 		if (vt_renderer.getWidth() != Term::width || vt_renderer.getHeight() != Term::height) {
 			vt_renderer.resize(Term::width, Term::height);
 		}
 		
 		// Check if this frame contains explicit clear commands
-		bool has_clear = (ansi_output.find("\033[2J") != string::npos || 
-		                  ansi_output.find("\033[0J") != string::npos ||
-		                  ansi_output.find("\033[1J") != string::npos);
+		bool has_clear = std::any_of(frame.begin(), frame.end(), [](const string_view& part) {
+			return (part.find("\033[2J") != string_view::npos ||
+			        part.find("\033[0J") != string_view::npos ||
+			        part.find("\033[1J") != string_view::npos);
+		});
 		
 		// Only clear if we see explicit clear commands or if this looks like a full redraw
 		// (starts with cursor positioning to 1,1)
-		bool starts_with_home = (ansi_output.find("\033[1;1") == 0 || 
-		                         ansi_output.find("\033[0;0") == 0 ||
-		                         ansi_output.find("\033[;") == 0);
+		auto first = std::find_if(frame.begin(), frame.end(), [](const string_view& part) { return not part.empty(); });
+		bool starts_with_home = (first != frame.end() &&
+		                         (first->starts_with("\033[1;1") ||
+		                          first->starts_with("\033[0;0") ||
+		                          first->starts_with("\033[;")));
 		
 		if (has_clear || starts_with_home) {
 			vt_renderer.clear();
 		}
 		
-		// Process the ANSI sequence
-		vt_renderer.processSequence(ansi_output);
+		// Process the ANSI sequences, parts never split an escape sequence so they can be fed one by one
+		for (const auto& part : frame) vt_renderer.processSequence(part);
 		
 		// Render to Resonite HTML format
 		return vt_renderer.renderToResoniteHTML();
@@ -19,6 +19,7 @@ tab-size = 4
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -29,7 +30,7 @@ tab-size = 4
 #include <winsock2.h>
 #include <ws2tcpip.h>
 
-using std::string, std::vector, std::thread, std::atomic;
+using std::string, std::string_view, std::vector, std::thread, std::atomic;
 
 namespace WebSocket {
 	
@@ -37,6 +38,8 @@ namespace WebSocket {
 	extern atomic<bool> should_stop;
 	extern int port;
 	extern thread server_thread;
+	extern atomic<int> active_clients;
+	extern atomic<bool> client_joined;
 	
 	struct Client {
 		SOCKET socket;
@@ -61,8 +64,8 @@ namespace WebSocket {
 	//* Send data to all connected clients
 	void broadcast(const string& data);
 	
-	//* Process ANSI output through VT renderer and convert to Resonite HTML
-	string processToResoniteHTML(const string& ansi_output);
+	//* Process ANSI output through VT renderer and convert to Resonite HTML, <frame> is processed in order as one continuous stream
+	string processToResoniteHTML(const vector<string_view>& frame);
 	
 	
 	//* Handle WebSocket handshake
@@ -1,8 +1,6 @@
 #include "vt_renderer.hpp"
-#include <sstream>
-#include <regex>
 #include <algorithm>
-#include <iomanip>
+#include <charconv>
 
 namespace VT {
 
@@ -11,6 +9,9 @@ Renderer::Renderer(int w, int h) : width(w), height(h), cursor_x(0), cursor_y(0)
     for (auto& row : grid) {
         row.resize(width);
     }
+    row_html.resize(height);
+    row_dirty.assign(height, true);
+    row_content.assign(height, false);
     
     // Set default style
     current_style.ch = U' ';
@@ -32,6 +33,9 @@ void Renderer::resize(int w, int h) {
     for (auto& row : grid) {
         row.resize(width);
     }
+    row_html.assign(height, std::string());
+    row_dirty.assign(height, true);
+    row_content.assign(height, false);
     cursor_x = cursor_y = 0;
 }
 
@@ -47,12 +51,21 @@ void Renderer::clear() {
     empty_cell.has_fg_color = false;
     empty_cell.has_bg_color = false;
     
-    for (auto& row : grid) {
-        std::fill(row.begin(), row.end(), empty_cell);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            setCell(x, y, empty_cell);
+        }
     }
     cursor_x = cursor_y = 0;
 }
 
+void Renderer::setCell(int x, int y, const Cell& cell) {
+    Cell& target = grid[y][x];
+    if (target == cell) return;
+    target = cell;
+    row_dirty[y] = true;
+}
+
 void Renderer::ensureValidCursor() {
     cursor_x = std::max(0, std::min(cursor_x, width - 1));
     cursor_y = std::max(0, std::min(cursor_y, height - 1));
@@ -92,14 +105,15 @@ uint32_t Renderer::ansi256ToRgb(int color) {
     return 0xCCCCCC; // Default
 }
 
-std::string Renderer::rgbToHex(uint32_t rgb) {
-    std::stringstream ss;
-    ss << "#" << std::hex << std::setfill('0') << std::setw(6) << (rgb & 0xFFFFFF);
-    return ss.str();
+void Renderer::appendHex(std::string& out, uint32_t rgb) {
+    static constexpr char digits[] = "0123456789abcdef";
+    out += '#';
+    for (int shift = 20; shift >= 0; shift -= 4) {
+        out += digits[(rgb >> shift) & 0xF];
+    }
 }
 
-std::string Renderer::utf8FromCodepoint(char32_t cp) {
-    std::string result;
+void Renderer::appendUtf8(std::string& result, char32_t cp) {
     if (cp <= 0x7F) {
         result += static_cast<char>(cp);
     } else if (cp <= 0x7FF) {
@@ -115,7 +129,6 @@ std::string Renderer::utf8FromCodepoint(char32_t cp) {
         result += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
         result += static_cast<char>(0x80 | (cp & 0x3F));
     }
-    return result;
 }
 
 void Renderer::parseSGR(const std::vector<int>& params) {
@@ -191,27 +204,25 @@ void Renderer::parseSGR(const std::vector<int>& params) {
     }
 }
 
-void Renderer::parseCSI(const std::string& sequence) {
+void Renderer::parseCSI(std::string_view sequence) {
     if (sequence.empty()) return;
     
     char final_byte = sequence.back();
-    std::string params = sequence.substr(0, sequence.length() - 1);
-    
-    // Parse parameters
-    std::vector<int> nums;
-    std::stringstream ss(params);
-    std::string token;
+    std::string_view params = sequence.substr(0, sequence.length() - 1);
     
-    while (std::getline(ss, token, ';')) {
-        if (!token.empty()) {
-            try {
-                nums.push_back(std::stoi(token));
-            } catch (...) {
-                nums.push_back(0);
-            }
+    // Parse parameters in place, a trailing ';' doesn't add an empty parameter
+    std::vector<int>& nums = csi_nums;
+    nums.clear();
+    for (size_t pos = 0; pos < params.length();) {
+        size_t next = std::min(params.find(';', pos), params.length());
+        if (next > pos) {
+            int value = 0;
+            auto result = std::from_chars(params.data() + pos, params.data() + next, value);
+            nums.push_back(result.ec == std::errc() ? value : 0);
         } else {
             nums.push_back(1); // Default parameter
         }
+        pos = next + 1;
     }
     
     if (nums.empty()) {
@@ -262,24 +273,24 @@ void Renderer::parseCSI(const std::string& sequence) {
             if (nums[0] == 0) { // Clear from cursor to end of display
                 // Clear from cursor to end of current line
                 for (int x = cursor_x; x < width; ++x) {
-                    grid[cursor_y][x] = Cell();
+                    setCell(x, cursor_y, Cell());
                 }
                 // Clear all lines below current line
                 for (int y = cursor_y + 1; y < height; ++y) {
                     for (int x = 0; x < width; ++x) {
-                        grid[y][x] = Cell();
+                        setCell(x, y, Cell());
                     }
                 }
             } else if (nums[0] == 1) { // Clear from start of display to cursor
                 // Clear all lines above current line
                 for (int y = 0; y < cursor_y; ++y) {
                     for (int x = 0; x < width; ++x) {
-                        grid[y][x] = Cell();
+                        setCell(x, y, Cell());
                     }
                 }
                 // Clear from start of current line to cursor
                 for (int x = 0; x <= cursor_x; ++x) {
-                    grid[cursor_y][x] = Cell();
+                    setCell(x, cursor_y, Cell());
                 }
             } else if (nums[0] == 2) { // Clear entire screen
                 clear();
@@ -288,15 +299,15 @@ void Renderer::parseCSI(const std::string& sequence) {
         case 'K': // Erase in Line
             if (nums[0] == 0) { // Clear from cursor to end of line
                 for (int x = cursor_x; x < width; ++x) {
-                    grid[cursor_y][x] = Cell();
+                    setCell(x, cursor_y, Cell());
                 }
             } else if (nums[0] == 1) { // Clear from start of line to cursor
                 for (int x = 0; x <= cursor_x; ++x) {
-                    grid[cursor_y][x] = Cell();
+                    setCell(x, cursor_y, Cell());
                 }
             } else if (nums[0] == 2) { // Clear entire line
                 for (int x = 0; x < width; ++x) {
-                    grid[cursor_y][x] = Cell();
+                    setCell(x, cursor_y, Cell());
                 }
             }
             break;
@@ -312,7 +323,7 @@ void Renderer::parseCSI(const std::string& sequence) {
     }
 }
 
-void Renderer::processSequence(const std::string& ansi_text) {
+void Renderer::processSequence(std::string_view ansi_text) {
     for (size_t i = 0; i < ansi_text.length(); ++i) {
         unsigned char ch = static_cast<unsigned char>(ansi_text[i]);
         
@@ -331,8 +342,7 @@ void Renderer::processSequence(const std::string& ansi_text) {
             }
             
             if (end < ansi_text.length()) {
-                std::string csi_params = ansi_text.substr(start, end - start + 1);
-                parseCSI(csi_params);
+                parseCSI(ansi_text.substr(start, end - start + 1));
                 i = end; // Skip past the CSI sequence
             }
         } else if (ch == '\n') {
@@ -398,9 +408,9 @@ void Renderer::processSequence(const std::string& ansi_text) {
             
             // Place the character in the grid
             if (cursor_y >= 0 && cursor_y < height && cursor_x >= 0 && cursor_x < width) {
-                Cell& cell = grid[cursor_y][cursor_x];
-                cell = current_style;
+                Cell cell = current_style;
                 cell.ch = codepoint;
+                setCell(cursor_x, cursor_y, cell);
                 cursor_x++;
                 
                 if (cursor_x >= width) {
@@ -416,104 +426,118 @@ void Renderer::processSequence(const std::string& ansi_text) {
     }
 }
 
-std::string Renderer::renderToResoniteHTML() {
-    std::string result;
-    result.reserve(grid.size() * grid[0].size() * 20); // Pre-allocate
-    
-    // Find the last line with content to avoid rendering trailing empty lines
-    int last_content_line = height - 1;
-    for (int y = height - 1; y >= 0; --y) {
-        bool line_has_content = false;
-        for (int x = 0; x < width; ++x) {
-            if (grid[y][x].ch != U' ' || grid[y][x].has_bg_color) {
-                line_has_content = true;
-                break;
-            }
-        }
-        if (line_has_content) {
-            last_content_line = y;
-            break;
-        }
-    }
+void Renderer::renderRow(int y) {
+    std::string& line = row_html[y];
+    line.clear();
+    row_content[y] = std::any_of(grid[y].begin(), grid[y].end(), [](const Cell& cell) {
+        return cell.ch != U' ' || cell.has_bg_color;
+    });
+
+    Cell last_style;
+    bool style_open = false;
+    bool first_char_in_line = true;
     
-    for (int y = 0; y <= last_content_line; ++y) {
+    for (int x = 0; x < width; ++x) {
+        const Cell& cell = grid[y][x];
         
-        Cell last_style;
-        bool style_open = false;
-        bool first_char_in_line = true;
+        // Check if we need to change style
+        bool style_changed = first_char_in_line || (
+            cell.bold != last_style.bold ||
+            cell.italic != last_style.italic ||
+            cell.underline != last_style.underline ||
+            cell.reverse != last_style.reverse ||
+            (cell.has_fg_color != last_style.has_fg_color) ||
+            (cell.has_bg_color != last_style.has_bg_color) ||
+            (cell.has_fg_color && last_style.has_fg_color && cell.fg_color != last_style.fg_color) ||
+            (cell.has_bg_color && last_style.has_bg_color && cell.bg_color != last_style.bg_color)
+        );
         
-        for (int x = 0; x < width; ++x) {
-            const Cell& cell = grid[y][x];
-            
-            // Check if we need to change style
-            bool style_changed = first_char_in_line || (
-                cell.bold != last_style.bold ||
-                cell.italic != last_style.italic ||
-                cell.underline != last_style.underline ||
-                cell.reverse != last_style.reverse ||
-                (cell.has_fg_color != last_style.has_fg_color) ||
-                (cell.has_bg_color != last_style.has_bg_color) ||
-                (cell.has_fg_color && last_style.has_fg_color && cell.fg_color != last_style.fg_color) ||
-                (cell.has_bg_color && last_style.has_bg_color && cell.bg_color != last_style.bg_color)
-            );
+        if (style_changed) {
+            // Close previous style if not first character in line
+            if (style_open && !first_char_in_line) {
+                line += "</closeall>";
+            }
+            style_open = false;
             
-            if (style_changed) {
-                // Close previous style if not first character in line
-                if (style_open && !first_char_in_line) {
-                    result += "</closeall>";
-                }
-                style_open = false;
+            // Open new style only if there are any style attributes
+            if (cell.bold || cell.italic || cell.underline || cell.reverse || 
+                cell.has_fg_color || cell.has_bg_color) {
                 
-                // Open new style only if there are any style attributes
-                if (cell.bold || cell.italic || cell.underline || cell.reverse || 
-                    cell.has_fg_color || cell.has_bg_color) {
-                    
-                    if (cell.has_fg_color) {
-                        result += "<color=" + rgbToHex(cell.fg_color) + ">";
-                    }
-                    if (cell.has_bg_color) {
-                        result += "<mark=" + rgbToHex(cell.bg_color) + ">";
-                    }
-                    if (cell.bold) {
-                        result += "<b>";
-                    }
-                    if (cell.italic) {
-                        result += "<i>";
-                    }
-                    if (cell.underline) {
-                        result += "<u>";
-                    }
-                    if (cell.reverse) {
-                        result += "<reverse>";
-                    }
-                    
-                    style_open = true;
+                if (cell.has_fg_color) {
+                    line += "<color=";
+                    appendHex(line, cell.fg_color);
+                    line += '>';
+                }
+                if (cell.has_bg_color) {
+                    line += "<mark=";
+                    appendHex(line, cell.bg_color);
+                    line += '>';
+                }
+                if (cell.bold) {
+                    line += "<b>";
+                }
+                if (cell.italic) {
+                    line += "<i>";
+                }
+                if (cell.underline) {
+                    line += "<u>";
+                }
+                if (cell.reverse) {
+                    line += "<reverse>";
                 }
                 
-                last_style = cell;
-                first_char_in_line = false;
+                style_open = true;
             }
             
-            // Add the character
-            if (cell.ch == U' ') {
-                result += " ";
-            } else {
-                result += utf8FromCodepoint(cell.ch);
-            }
+            last_style = cell;
+            first_char_in_line = false;
         }
         
-        // Close any open style at end of line
-        if (style_open) {
-            result += "</closeall>";
-            style_open = false;
+        // Add the character
+        if (cell.ch == U' ') {
+            line += " ";
+        } else {
+            appendUtf8(line, cell.ch);
         }
-        
+    }
+    
+    // Close any open style at end of line
+    if (style_open) {
+        line += "</closeall>";
+        style_open = false;
+    }
+
+    row_dirty[y] = false;
+}
+
+std::string Renderer::renderToResoniteHTML() {
+    // Only rows written with different cells since the last call are converted again, the rest are reused as is
+    size_t size = 0;
+    for (int y = 0; y < height; ++y) {
+        if (row_dirty[y]) renderRow(y);
+        size += row_html[y].size() + 4;
+    }
+
+    // Find the last line with content to avoid rendering trailing empty lines
+    int last_content_line = height - 1;
+    for (int y = height - 1; y >= 0; --y) {
+        if (row_content[y]) {
+            last_content_line = y;
+            break;
+        }
+    }
+
+    std::string result;
+    result.reserve(size);
+    for (int y = 0; y <= last_content_line; ++y) {
+        result += row_html[y];
+
         // Add line break except for the last rendered line
         if (y < last_content_line) {
             result += "<br>";
         }
     }
-    
+
     return result;
 }
 
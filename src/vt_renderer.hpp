@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 
@@ -15,6 +16,8 @@ namespace VT {
         uint32_t bg_color = 0x000000; // Default black
         bool has_fg_color = false;
         bool has_bg_color = false;
+
+        bool operator==(const Cell&) const = default;
     };
 
     class Renderer {
@@ -23,20 +26,30 @@ namespace VT {
         int width, height;
         int cursor_x, cursor_y;
         Cell current_style;
+
+        // Converted html per row, rows are only converted again when a cell in them changed
+        std::vector<std::string> row_html;
+        std::vector<bool> row_dirty;
+        std::vector<bool> row_content;
+
+        // Parameters of the last CSI sequence, reused so parsing doesn't allocate
+        std::vector<int> csi_nums;
         
         // Helper functions
+        void setCell(int x, int y, const Cell& cell);
+        void renderRow(int y);
         void ensureValidCursor();
-        void parseCSI(const std::string& sequence);
+        void parseCSI(std::string_view sequence);
         void parseSGR(const std::vector<int>& params);
         uint32_t ansi256ToRgb(int color);
-        std::string rgbToHex(uint32_t rgb);
-        std::string utf8FromCodepoint(char32_t cp);
+        void appendHex(std::string& out, uint32_t rgb);
+        void appendUtf8(std::string& result, char32_t cp);
         
     public:
         Renderer(int w = 120, int h = 30);
         void resize(int w, int h);
         void clear();
-        void processSequence(const std::string& ansi_text);
+        void processSequence(std::string_view ansi_text);
         std::string renderToResoniteHTML();
         
         // Getters